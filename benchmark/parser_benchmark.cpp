@@ -0,0 +1,369 @@
+// Copyright (c) 2026 Robert Vaser
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "bioparser/bam_parser.hpp"
+#include "bioparser/block_inflater.hpp"
+#include "bioparser/fasta_parser.hpp"
+#include "bioparser/fastq_parser.hpp"
+#include "bioparser/mhap_parser.hpp"
+#include "bioparser/paf_parser.hpp"
+#include "bioparser/sam_parser.hpp"
+#include "bioparser/scanner.hpp"
+
+#include "bioparser_benchmark_config.h"
+
+namespace bioparser {
+namespace benchmark {
+
+struct Sequence {
+ public:
+  Sequence(
+      const char* name, std::uint32_t name_len,
+      const char* data, std::uint32_t data_len)
+      : name(name, name_len),
+        data(data, data_len) {}
+
+  Sequence(
+      const char* name, std::uint32_t name_len,
+      const char* data, std::uint32_t data_len,
+      const char* quality, std::uint32_t quality_len)
+      : name(name, name_len),
+        data(data, data_len),
+        quality(quality, quality_len) {}
+
+  std::string name;
+  std::string data;
+  std::string quality;
+};
+
+struct SequenceView {
+ public:
+  SequenceView(
+      const char* name, std::uint64_t name_len,
+      const char* data, std::uint64_t data_len)
+      : name(name),
+        name_len(name_len),
+        data(data),
+        data_len(data_len) {}
+
+  SequenceView(
+      const char* name, std::uint64_t name_len,
+      const char* data, std::uint64_t data_len,
+      const char*, std::uint64_t)
+      : SequenceView(name, name_len, data, data_len) {}
+
+  const char* name;
+  std::uint64_t name_len;
+  const char* data;
+  std::uint64_t data_len;
+};
+
+struct Overlap {
+ public:
+  Overlap(  // MHAP
+      std::uint64_t lhs_id,
+      std::uint64_t rhs_id,
+      double,
+      std::uint32_t,
+      std::uint32_t,
+      std::uint32_t lhs_begin,
+      std::uint32_t lhs_end,
+      std::uint32_t,
+      std::uint32_t,
+      std::uint32_t rhs_begin,
+      std::uint32_t rhs_end,
+      std::uint32_t)
+      : lhs_name(std::to_string(lhs_id)),
+        lhs_begin(lhs_begin),
+        lhs_end(lhs_end),
+        rhs_name(std::to_string(rhs_id)),
+        rhs_begin(rhs_begin),
+        rhs_end(rhs_end) {}
+
+  Overlap(  // PAF
+      const char* q_name, std::uint32_t q_name_len,
+      std::uint32_t,
+      std::uint32_t q_begin,
+      std::uint32_t q_end,
+      char,
+      const char* t_name, std::uint32_t t_name_len,
+      std::uint32_t,
+      std::uint32_t t_begin,
+      std::uint32_t t_end,
+      std::uint32_t,
+      std::uint32_t,
+      std::uint32_t)
+      : lhs_name(q_name, q_name_len),
+        lhs_begin(q_begin),
+        lhs_end(q_end),
+        rhs_name(t_name, t_name_len),
+        rhs_begin(t_begin),
+        rhs_end(t_end) {}
+
+  Overlap(  // SAM
+      const char* q_name, std::uint32_t q_name_len,
+      std::uint32_t,
+      const char* t_name, std::uint32_t t_name_len,
+      std::uint32_t t_begin,
+      std::uint32_t,
+      const char* cigar, std::uint32_t cigar_len,
+      const char*, std::uint32_t,
+      std::uint32_t,
+      std::uint32_t,
+      const char*, std::uint32_t,
+      const char*, std::uint32_t)
+      : lhs_name(q_name, q_name_len),
+        lhs_begin(0),
+        lhs_end(0),
+        rhs_name(t_name, t_name_len),
+        rhs_begin(t_begin),
+        rhs_end(0),
+        alignment(cigar, cigar_len) {}
+
+  std::string lhs_name;
+  std::uint32_t lhs_begin;
+  std::uint32_t lhs_end;
+  std::string rhs_name;
+  std::uint32_t rhs_begin;
+  std::uint32_t rhs_end;
+  std::string alignment;
+};
+
+struct Fixture {
+  std::string path;
+  std::uint64_t bytes;  // decompressed
+};
+
+// concatenates a test file num_copies times into a gzip compressed file
+const Fixture& Scale(const std::string& file, std::uint32_t num_copies) {
+  static std::map<std::string, Fixture> fixtures;
+  auto it = fixtures.find(file);
+  if (it != fixtures.end()) {
+    return it->second;
+  }
+
+  auto src = gzopen((BIOPARSER_BENCHMARK_DATA + file).c_str(), "r");
+  if (src == nullptr) {
+    throw std::invalid_argument(
+        "[bioparser::benchmark::Scale] error: unable to open file " + file);
+  }
+  std::string data;
+  std::vector<char> buffer(65536, 0);
+  for (int bytes; (bytes = gzread(src, buffer.data(), buffer.size())) > 0;) {
+    data.append(buffer.data(), bytes);
+  }
+  gzclose(src);
+
+  Fixture fixture{BIOPARSER_BENCHMARK_OUTPUT + ("scaled_" + file), 0};
+  auto dst = gzopen(fixture.path.c_str(), "w");
+  if (dst == nullptr) {
+    throw std::invalid_argument(
+        "[bioparser::benchmark::Scale] error: unable to create file " +
+        fixture.path);
+  }
+  for (std::uint32_t i = 0; i < num_copies; ++i) {
+    gzwrite(dst, data.data(), data.size());
+    fixture.bytes += data.size();
+  }
+  gzclose(dst);
+
+  return fixtures.emplace(file, fixture).first->second;
+}
+
+template<template<class> class P, class T>
+void Parse(::benchmark::State& state, const std::string& file) {
+  const auto& fixture = Scale(file, 128);
+
+  Options options;
+  options.read_ahead = state.range(0);
+
+  for (auto _ : state) {
+    auto p = Parser<T>::template Create<P>(fixture.path, options);
+    auto records = p->Parse(-1);
+    ::benchmark::DoNotOptimize(records.data());
+  }
+  state.SetBytesProcessed(state.iterations() * fixture.bytes);
+}
+
+// passes records to a callback instead of collecting them
+template<template<class> class P>
+void Visit(::benchmark::State& state, const std::string& file) {
+  const auto& fixture = Scale(file, 128);
+
+  Options options;
+  options.read_ahead = state.range(0);
+
+  for (auto _ : state) {
+    auto p = Parser<SequenceView>::template Create<P>(fixture.path, options);
+    std::uint64_t data_len = 0;
+    p->Parse(-1, [&] (SequenceView&& it) { data_len += it.data_len; });
+    ::benchmark::DoNotOptimize(data_len);
+  }
+  state.SetBytesProcessed(state.iterations() * fixture.bytes);
+}
+
+void FastaParse(::benchmark::State& state) {
+  Parse<FastaParser, Sequence>(state, "sample.fasta.gz");
+}
+
+void FastqParse(::benchmark::State& state) {
+  Parse<FastqParser, Sequence>(state, "sample.fastq.gz");
+}
+
+void FastaVisit(::benchmark::State& state) {
+  Visit<FastaParser>(state, "sample.fasta.gz");
+}
+
+void FastqVisit(::benchmark::State& state) {
+  Visit<FastqParser>(state, "sample.fastq.gz");
+}
+
+void MhapParse(::benchmark::State& state) {
+  Parse<MhapParser, Overlap>(state, "sample.mhap.gz");
+}
+
+void PafParse(::benchmark::State& state) {
+  Parse<PafParser, Overlap>(state, "sample.paf.gz");
+}
+
+void SamParse(::benchmark::State& state) {
+  Parse<SamParser, Overlap>(state, "sample.sam.gz");
+}
+
+// BAM files can not be concatenated, throughput is given in bytes of the
+// equivalent SAM file to compare with SamParse
+void BamParse(::benchmark::State& state) {
+  auto sam_bytes = Scale("sample.sam.gz", 128).bytes / 128;
+
+  Options options;
+  options.read_ahead = state.range(0);
+
+  for (auto _ : state) {
+    auto p = Parser<Overlap>::Create<BamParser>(
+        BIOPARSER_BENCHMARK_DATA + std::string("sample.bam"),
+        options);
+    auto records = p->Parse(-1);
+    ::benchmark::DoNotOptimize(records.data());
+  }
+  state.SetBytesProcessed(state.iterations() * sam_bytes);
+}
+
+// inflates the scaled FASTQ file cut into raw deflate blocks of BGZF size,
+// throughput is given in decompressed bytes
+void Inflate(::benchmark::State& state, BlockInflater::Backend backend) {
+  struct Block {
+    std::vector<char> src;
+    std::uint32_t data_len;
+    std::uint32_t crc;
+  };
+  static std::vector<Block> blocks;
+  static std::uint64_t bytes = 0;
+  if (blocks.empty()) {
+    auto src = gzopen(Scale("sample.fastq.gz", 128).path.c_str(), "r");
+    std::vector<char> data(65280);  // as bgzip
+    for (int len; (len = gzread(src, data.data(), data.size())) > 0;) {
+      z_stream strm;
+      std::memset(&strm, 0, sizeof(strm));
+      deflateInit2(&strm, 6, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+      Block block{std::vector<char>(deflateBound(&strm, len)), 0, 0};
+      strm.next_in = reinterpret_cast<Bytef*>(data.data());
+      strm.avail_in = len;
+      strm.next_out = reinterpret_cast<Bytef*>(block.src.data());
+      strm.avail_out = block.src.size();
+      deflate(&strm, Z_FINISH);
+      block.src.resize(strm.total_out);
+      deflateEnd(&strm);
+      block.data_len = len;
+      block.crc = crc32(crc32(0, Z_NULL, 0),
+          reinterpret_cast<Bytef*>(data.data()), len);
+      blocks.emplace_back(std::move(block));
+      bytes += len;
+    }
+    gzclose(src);
+  }
+
+  BlockInflater inflater(backend);
+  std::vector<char> dst(65536);
+  for (auto _ : state) {
+    for (const auto& it : blocks) {
+      if (!inflater.Inflate(
+          it.src.data(), it.src.size(), dst.data(), it.data_len, it.crc)) {
+        state.SkipWithError("invalid block");
+        return;
+      }
+    }
+    ::benchmark::DoNotOptimize(dst.data());
+  }
+  state.SetBytesProcessed(state.iterations() * bytes);
+  if (backend == BlockInflater::Backend::kZlib) {
+    state.SetLabel(zlibVersion());  // shows zlib-ng in compat mode
+  }
+}
+
+BENCHMARK_CAPTURE(Inflate, Zlib, BlockInflater::Backend::kZlib);
+#if defined(BIOPARSER_USE_LIBDEFLATE)
+BENCHMARK_CAPTURE(Inflate, Libdeflate, BlockInflater::Backend::kLibdeflate);
+#endif
+
+// counts lines of 150 bp in 1 MB of data
+void Scan(::benchmark::State& state, Scanner::Kernel kernel) {
+  std::string data;
+  while (data.size() < (1U << 20)) {
+    data += std::string(150, 'A') + '\n';
+  }
+  for (auto _ : state) {
+    std::uint32_t num_lines = 0;
+    for (auto it = data.data(), end = it + data.size();; ++it) {
+      it = kernel(it, end, '\n', '\n');
+      if (it == end) {
+        break;
+      }
+      ++num_lines;
+    }
+    ::benchmark::DoNotOptimize(num_lines);
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+BENCHMARK_CAPTURE(Scan, Scalar, &Scanner::Scalar);
+#if defined(BIOPARSER_HAS_SSE2)
+BENCHMARK_CAPTURE(Scan, Sse2, &Scanner::Sse2);
+#endif
+#if defined(BIOPARSER_HAS_AVX2)
+void ScanAvx2(::benchmark::State& state) {
+  if (!__builtin_cpu_supports("avx2")) {
+    state.SkipWithError("AVX2 is not supported");
+    return;
+  }
+  Scan(state, &Scanner::Avx2);
+}
+BENCHMARK(ScanAvx2);
+#endif
+#if defined(BIOPARSER_HAS_NEON)
+BENCHMARK_CAPTURE(Scan, Neon, &Scanner::Neon);
+#endif
+
+// argument is Options::read_ahead, 0 being the synchronous mode
+BENCHMARK(FastaParse)->ArgName("read_ahead")->Arg(0)->Arg(4)->UseRealTime();
+BENCHMARK(FastqParse)->ArgName("read_ahead")->Arg(0)->Arg(4)->UseRealTime();
+BENCHMARK(FastaVisit)->ArgName("read_ahead")->Arg(0)->Arg(4)->UseRealTime();
+BENCHMARK(FastqVisit)->ArgName("read_ahead")->Arg(0)->Arg(4)->UseRealTime();
+BENCHMARK(MhapParse)->ArgName("read_ahead")->Arg(0)->Arg(4)->UseRealTime();
+BENCHMARK(PafParse)->ArgName("read_ahead")->Arg(0)->Arg(4)->UseRealTime();
+BENCHMARK(SamParse)->ArgName("read_ahead")->Arg(0)->Arg(4)->UseRealTime();
+BENCHMARK(BamParse)->ArgName("read_ahead")->Arg(0)->Arg(4)->UseRealTime();
+
+}  // namespace benchmark
+}  // namespace bioparser
+
+BENCHMARK_MAIN();
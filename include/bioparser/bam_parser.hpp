@@ -0,0 +1,434 @@
+// Copyright (c) 2026 Robert Vaser
+
+#ifndef BIOPARSER_BAM_PARSER_HPP_
+#define BIOPARSER_BAM_PARSER_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "bioparser/parser.hpp"
+#include "bioparser/sam_header.hpp"
+#include "bioparser/tags.hpp"
+
+namespace bioparser {
+
+// decodes binary SAM records (BGZF compressed) into the same arguments as
+// SamParser, i.e. text CIGAR strings, sequences, qualities and optional fields
+template<class T>
+class BamParser: public Parser<T> {
+ public:
+  BamParser(const BamParser&) = delete;
+  BamParser& operator=(const BamParser&) = delete;
+
+  BamParser(BamParser&&) = delete;
+  BamParser& operator=(BamParser&&) = delete;
+
+  ~BamParser() {}
+
+  // returns the header lines, with @SQ lines synthesized from the binary
+  // reference list if the header text has none
+  const SamHeader& header() {
+    if (!is_header_done_) {
+      is_header_only_ = true;
+      ParseRecords(-1, true);
+      is_header_only_ = false;
+    }
+    return header_;
+  }
+
+ private:
+  std::uint64_t ParseRecords(
+      std::uint64_t bytes, bool shorten_names) override {
+    std::uint64_t num_records = 0;
+    std::uint64_t parsed_bytes = 0;
+    bool is_eof = false;
+
+    // stores the next count bytes, returns false at the end of file
+    auto take = [&] (std::uint64_t count) -> bool {
+      while (count > 0) {
+        if (this->buffer_ptr() == this->buffer_bytes()) {
+          if (is_eof) {
+            return false;
+          }
+          is_eof = this->Read();
+          continue;
+        }
+        auto len = std::min(count, this->buffer_bytes() - this->buffer_ptr());
+        this->Take(len);
+        count -= len;
+      }
+      return true;
+    };
+
+    if (this->offset() == 0) {  // header is skipped after Reset() as well
+      DecodeHeader([&] (std::uint64_t count) -> const char* {
+        this->Clear();
+        if (!take(count)) {
+          throw std::invalid_argument(
+              "[bioparser::BamParser] error: invalid file format");
+        }
+        return this->Span(0, count);
+      });
+      this->Clear();
+    } else if (!is_header_done_) {  // parser starts in the middle of the file
+      LoadHeader();
+    }
+    if (is_header_only_) {
+      return num_records;
+    }
+
+    while (true) {
+      if (!take(4)) {
+        if (this->storage_ptr() != 0) {
+          throw std::invalid_argument(
+              "[bioparser::BamParser] error: invalid file format");
+        }
+        break;
+      }
+      auto block_size = Unpack<std::uint32_t>(this->Span(0, 4));
+      if (block_size < 32 || !take(block_size)) {
+        throw std::invalid_argument(
+            "[bioparser::BamParser] error: invalid file format");
+      }
+      Decode(this->Span(4, 4 + block_size), block_size, shorten_names);
+      ++num_records;
+
+      parsed_bytes += this->storage_ptr();
+      this->Clear();
+      if (parsed_bytes >= bytes) {
+        break;
+      }
+    }
+
+    return num_records;
+  }
+
+  // magic, header text and the list of reference names and lengths; read
+  // returns a pointer to the next count bytes, which is valid until the next
+  // call
+  template<class F>
+  void DecodeHeader(F&& read) {
+    if (std::memcmp(read(4), "BAM\1", 4) != 0) {
+      throw std::invalid_argument(
+          "[bioparser::BamParser] error: invalid file format");
+    }
+    auto text_len = Unpack<std::uint32_t>(read(4));
+    SamHeader header;
+    auto text = read(text_len);
+    bool has_references = false;
+    for (auto first = text, last = text + text_len; first < last;) {
+      auto end = std::find(first, last, '\n');
+      auto len = this->RightStrip(first, std::find(first, end, '\0') - first);
+      if (len > 0) {
+        header.Add(first, len);
+        has_references |= len > 2 && first[1] == 'S' && first[2] == 'Q';
+      }
+      first = end + 1;
+    }
+
+    std::vector<std::string> names;
+    auto num_references = Unpack<std::uint32_t>(read(4));
+    for (std::uint32_t i = 0; i < num_references; ++i) {
+      auto name_len = Unpack<std::uint32_t>(read(4));
+      auto name = read(name_len + 4);
+      if (name_len == 0 || name[name_len - 1] != '\0') {
+        throw std::invalid_argument(
+            "[bioparser::BamParser] error: invalid file format");
+      }
+      names.emplace_back(name, name_len - 1);
+      if (!has_references) {
+        auto line = "@SQ\tSN:" + names.back() + "\tLN:" +
+            std::to_string(Unpack<std::uint32_t>(name + name_len));
+        header.Add(line.data(), line.size());
+      }
+    }
+
+    if (!is_header_done_) {
+      header_ = std::move(header);
+      names_ = std::move(names);
+      is_header_done_ = true;
+    }
+  }
+
+  void LoadHeader() {
+    auto file = gzopen(this->path().c_str(), "r");
+    if (file == nullptr) {
+      throw std::invalid_argument(
+          "[bioparser::BamParser] error: unable to open file " + this->path());
+    }
+    GzReader reader(file);
+    std::vector<char> buffer;
+    DecodeHeader([&] (std::uint64_t count) -> const char* {
+      buffer.resize(count);
+      if (reader.Read(buffer.data(), count) != count) {
+        throw std::invalid_argument(
+            "[bioparser::BamParser] error: invalid file format");
+      }
+      return buffer.data();
+    });
+  }
+
+  void Decode(const char* record, std::uint32_t size, bool shorten_names) {
+    auto t_id = Unpack<std::int32_t>(record);
+    auto t_begin = Unpack<std::int32_t>(record + 4);
+    std::uint32_t q_name_len = static_cast<std::uint8_t>(record[8]);
+    std::uint32_t map_quality = static_cast<std::uint8_t>(record[9]);
+    auto num_operations = Unpack<std::uint16_t>(record + 12);
+    std::uint32_t flag = Unpack<std::uint16_t>(record + 14);
+    auto data_len = Unpack<std::uint32_t>(record + 16);
+    auto t_next_id = Unpack<std::int32_t>(record + 20);
+    auto t_next_begin = Unpack<std::int32_t>(record + 24);
+    std::int64_t template_len = Unpack<std::int32_t>(record + 28);
+
+    std::uint64_t tags_ptr = 32 + q_name_len + 4ULL * num_operations +
+        (data_len + 1ULL) / 2 + data_len;
+    if (q_name_len < 2 || tags_ptr > size ||
+        record[32 + q_name_len - 1] != '\0' ||
+        t_id < -1 || t_id >= static_cast<std::int64_t>(names_.size()) ||
+        t_next_id < -1 || t_next_id >= static_cast<std::int64_t>(names_.size())) {  // NOLINT
+      throw std::invalid_argument(
+          "[bioparser::BamParser] error: invalid file format");
+    }
+
+    auto q_name = record + 32;
+    auto q_name_size = shorten_names ?
+        this->Shorten(q_name, q_name_len - 1) :
+        this->RightStrip(q_name, q_name_len - 1);
+
+    static const std::string kStar = "*";
+    static const std::string kEqual = "=";
+    const auto& t_name = t_id < 0 ? kStar : names_[t_id];
+    const auto& t_next_name = t_next_id < 0 ?
+        kStar :
+        (t_next_id == t_id ? kEqual : names_[t_next_id]);
+    auto t_name_len = shorten_names ?
+        this->Shorten(t_name.data(), t_name.size()) :
+        t_name.size();
+    auto t_next_name_len = shorten_names ?
+        this->Shorten(t_next_name.data(), t_next_name.size()) :
+        t_next_name.size();
+
+    auto operations = record + 32 + q_name_len;
+    cigar_.clear();
+    for (std::uint32_t i = 0; i < num_operations; ++i) {
+      auto operation = Unpack<std::uint32_t>(operations + 4 * i);
+      if ((operation & 15) > 8) {
+        throw std::invalid_argument(
+            "[bioparser::BamParser] error: invalid file format");
+      }
+      char str[11];  // at most 10 digits and the operation
+      auto len = 11;
+      str[--len] = "MIDNSHP=X"[operation & 15];
+      for (auto value = operation >> 4; len == 10 || value > 0; value /= 10) {
+        str[--len] = static_cast<char>('0' + value % 10);
+      }
+      cigar_.append(str + len, 11 - len);
+    }
+    if (cigar_.empty()) {
+      cigar_ = kStar;
+    }
+
+    auto data = operations + 4 * num_operations;
+    auto quality = data + (data_len + 1) / 2;
+    data_.resize(std::max(data_len, 1U));
+    quality_.resize(std::max(data_len, 1U));
+    if (data_len == 0) {
+      data_[0] = '*';
+      quality_[0] = '*';
+    } else {
+      DecodeSequence(data, data_len, &data_[0]);
+      if (static_cast<std::uint8_t>(quality[0]) == 255) {
+        quality_.resize(1);
+        quality_[0] = '*';
+      } else {
+        for (std::uint32_t i = 0; i < data_len; ++i) {
+          quality_[i] = static_cast<char>(quality[i] + 33);
+        }
+      }
+    }
+
+    DecodeTags(record + tags_ptr, record + size);
+
+    this->EmitTagged(
+        tags_.data(), tags_.size(),
+        q_name, q_name_size,
+        flag,
+        t_name.data(), t_name_len, static_cast<std::uint64_t>(t_begin + 1),
+        map_quality,
+        cigar_.data(), cigar_.size(),
+        t_next_name.data(), t_next_name_len,
+        static_cast<std::uint64_t>(t_next_begin + 1),
+        template_len,
+        data_.data(), data_.size(),
+        quality_.data(), quality_.size());
+  }
+
+  // converts binary optional fields to their text form, e.g. NM:i:0
+  void DecodeTags(const char* first, const char* last) {
+    auto error = [] () -> void {
+      throw std::invalid_argument(
+          "[bioparser::BamParser] error: invalid optional field");
+    };
+    tags_.clear();
+    while (first < last) {
+      if (last - first < 4) {
+        error();
+      }
+      if (!tags_.empty()) {
+        tags_.push_back('\t');
+      }
+      tags_.append(first, 2);
+      auto type = first[2];
+      first += 3;
+      switch (type) {
+        case 'A':
+          tags_ += ":A:";
+          tags_.push_back(*first++);
+          break;
+        case 'Z':
+        case 'H': {
+          auto end = std::find(first, last, '\0');
+          if (end == last) {
+            error();
+          }
+          tags_.push_back(':');
+          tags_.push_back(type);
+          tags_.push_back(':');
+          tags_.append(first, end);
+          first = end + 1;
+          break;
+        }
+        case 'B': {
+          if (last - first < 5) {
+            error();
+          }
+          auto subtype = first[0];
+          auto count = Unpack<std::uint32_t>(first + 1);
+          auto size = Size(subtype);
+          first += 5;
+          if (size == 0 || static_cast<std::uint64_t>(last - first) < static_cast<std::uint64_t>(count) * size) {  // NOLINT
+            error();
+          }
+          tags_ += ":B:";
+          tags_.push_back(subtype);
+          for (std::uint32_t i = 0; i < count; ++i, first += size) {
+            tags_.push_back(',');
+            AppendValue(subtype, first);
+          }
+          break;
+        }
+        default: {
+          auto size = Size(type);
+          if (size == 0 || static_cast<std::uint64_t>(last - first) < size) {
+            error();
+          }
+          tags_ += type == 'f' ? ":f:" : ":i:";
+          AppendValue(type, first);
+          first += size;
+          break;
+        }
+      }
+    }
+  }
+
+  // returns 0 for unknown numeric types
+  static std::uint32_t Size(char type) {
+    switch (type) {
+      case 'c': case 'C': return 1;
+      case 's': case 'S': return 2;
+      case 'i': case 'I': case 'f': return 4;
+      default: return 0;
+    }
+  }
+
+  void AppendValue(char type, const char* src) {
+    switch (type) {
+      case 'c': tags_ += std::to_string(Unpack<std::int8_t>(src)); break;
+      case 'C': tags_ += std::to_string(Unpack<std::uint8_t>(src)); break;
+      case 's': tags_ += std::to_string(Unpack<std::int16_t>(src)); break;
+      case 'S': tags_ += std::to_string(Unpack<std::uint16_t>(src)); break;
+      case 'i': tags_ += std::to_string(Unpack<std::int32_t>(src)); break;
+      case 'I': tags_ += std::to_string(Unpack<std::uint32_t>(src)); break;
+      default: {  // f
+        auto bits = Unpack<std::uint32_t>(src);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        char str[32];
+        auto len = std::snprintf(str, sizeof(str), "%g", value);
+        tags_.append(str, len);
+        break;
+      }
+    }
+  }
+
+  // little-endian integers
+  template<class I>
+  static I Unpack(const char* src) {
+    typename std::make_unsigned<I>::type dst = 0;
+    for (std::uint32_t i = 0; i < sizeof(I); ++i) {
+      dst |= static_cast<typename std::make_unsigned<I>::type>(
+          static_cast<std::uint8_t>(src[i])) << (8 * i);
+    }
+    return static_cast<I>(dst);
+  }
+
+  // decodes 4-bit nucleotides two at a time through a table of pairs
+  static void DecodeSequence(const char* src, std::uint32_t len, char* dst) {
+    static const std::array<char, 512> kPairs = [] () {
+      const char* kCodes = "=ACMGRSVTWYHKDBN";
+      std::array<char, 512> dst{};
+      for (std::uint32_t i = 0; i < 256; ++i) {
+        dst[2 * i] = kCodes[i >> 4];
+        dst[2 * i + 1] = kCodes[i & 15];
+      }
+      return dst;
+    }();
+    for (std::uint32_t i = 0; i < len / 2; ++i) {
+      std::memcpy(dst + 2 * i, &kPairs[2 * static_cast<std::uint8_t>(src[i])], 2);  // NOLINT
+    }
+    if (len & 1) {
+      dst[len - 1] = kPairs[2 * static_cast<std::uint8_t>(src[len / 2])];
+    }
+  }
+
+  // random access within BAM files would need a BAI index
+  static std::uint64_t Resync(const char*, std::uint64_t, std::uint64_t) {
+    throw std::invalid_argument(
+        "[bioparser::BamParser] error: random access is not supported");
+  }
+
+  explicit BamParser(Reader* reader)
+      : Parser<T>(reader, 65536),  // 64 kB
+        header_(),
+        names_(),
+        cigar_(),
+        data_(),
+        quality_(),
+        tags_(),
+        is_header_done_(false),
+        is_header_only_(false) {}
+
+  SamHeader header_;
+  std::vector<std::string> names_;  // of references by id
+  std::string cigar_;
+  std::string data_;
+  std::string quality_;
+  std::string tags_;
+  bool is_header_done_;
+  bool is_header_only_;
+
+  friend Parser<T>;
+};
+
+}  // namespace bioparser
+
+#endif  // BIOPARSER_BAM_PARSER_HPP_
@@ -0,0 +1,226 @@
+// Copyright (c) 2026 Robert Vaser
+
+#ifndef BIOPARSER_BATCH_HPP_
+#define BIOPARSER_BATCH_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace bioparser {
+
+template<class T>
+class Parser;
+
+// hands out memory from large slabs which are released together, slabs are
+// kept on Clear() for reuse
+class Arena {
+ public:
+  explicit Arena(std::size_t slab_size = 1U << 20)  // 1 MB
+      : slab_size_(std::max<std::size_t>(slab_size, 1)),
+        slabs_(),
+        current_(0),
+        ptr_(0) {}
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  Arena(Arena&& other)
+      : slab_size_(other.slab_size_),
+        slabs_(std::move(other.slabs_)),
+        current_(other.current_),
+        ptr_(other.ptr_) {
+    other.slabs_.clear();
+    other.Clear();
+  }
+
+  Arena& operator=(Arena&& other) {
+    if (this != &other) {
+      slab_size_ = other.slab_size_;
+      slabs_ = std::move(other.slabs_);
+      current_ = other.current_;
+      ptr_ = other.ptr_;
+      other.slabs_.clear();
+      other.Clear();
+    }
+    return *this;
+  }
+
+  ~Arena() {}
+
+  void* Allocate(std::size_t size, std::size_t alignment) {
+    while (true) {
+      if (current_ == slabs_.size()) {
+        slabs_.emplace_back(std::max(slab_size_, size + alignment));
+      } else if (slabs_[current_].size < size + alignment && ptr_ == 0) {
+        auto it = std::find_if(  // oversized request, reuse an unused slab
+            slabs_.begin() + current_, slabs_.end(),
+            [&] (const Slab& slab) -> bool {
+              return slab.size >= size + alignment;
+            });
+        if (it == slabs_.end()) {
+          slabs_.emplace(slabs_.begin() + current_, size + alignment);
+        } else {
+          std::swap(slabs_[current_], *it);
+        }
+      }
+      auto& slab = slabs_[current_];
+      auto base = reinterpret_cast<std::uintptr_t>(slab.data.get());
+      auto begin = (base + ptr_ + alignment - 1) / alignment * alignment;
+      if (begin + size <= base + slab.size) {
+        ptr_ = begin + size - base;
+        return reinterpret_cast<void*>(begin);
+      }
+      ++current_;
+      ptr_ = 0;
+    }
+  }
+
+  void Clear() {
+    current_ = 0;
+    ptr_ = 0;
+  }
+
+  std::size_t num_slabs() const {
+    return slabs_.size();
+  }
+
+ private:
+  struct Slab {
+    explicit Slab(std::size_t size)
+        : data(new char[size]),
+          size(size) {}
+
+    std::unique_ptr<char[]> data;
+    std::size_t size;
+  };
+
+  std::size_t slab_size_;
+  std::vector<Slab> slabs_;
+  std::size_t current_;
+  std::size_t ptr_;  // in current slab
+};
+
+// records parsed into an arena, iterating yields T*; records are kept alive
+// between Parse() calls and overwritten in place by the next batch, through
+// T::Assign() with the constructor arguments if T provides one, so that
+// steady-state parsing does not allocate
+template<class T>
+class Batch {
+ public:
+  using const_iterator = typename std::vector<T*>::const_iterator;
+
+  explicit Batch(std::size_t slab_size = 1U << 20)  // 1 MB
+      : arena_(slab_size),
+        records_(),
+        size_(0) {}
+
+  Batch(const Batch&) = delete;
+  Batch& operator=(const Batch&) = delete;
+
+  Batch(Batch&& other)
+      : arena_(std::move(other.arena_)),
+        records_(std::move(other.records_)),
+        size_(other.size_) {
+    other.records_.clear();
+    other.size_ = 0;
+  }
+
+  Batch& operator=(Batch&& other) {
+    if (this != &other) {
+      Clear();
+      arena_ = std::move(other.arena_);
+      records_ = std::move(other.records_);
+      size_ = other.size_;
+      other.records_.clear();
+      other.size_ = 0;
+    }
+    return *this;
+  }
+
+  ~Batch() {
+    Clear();
+  }
+
+  std::size_t size() const {
+    return size_;
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  T& operator[](std::size_t i) const {
+    return *records_[i];
+  }
+
+  const_iterator begin() const {
+    return records_.begin();
+  }
+
+  const_iterator end() const {
+    return records_.begin() + size_;
+  }
+
+  const Arena& arena() const {
+    return arena_;
+  }
+
+  // destroys all records including the ones kept for reuse, memory is kept
+  // for the next batch
+  void Clear() {
+    for (auto it : records_) {
+      it->~T();
+    }
+    records_.clear();
+    size_ = 0;
+    arena_.Clear();
+  }
+
+ private:
+  friend Parser<T>;
+
+  void Recycle() {
+    size_ = 0;
+  }
+
+  template<class... Args>
+  void Emplace(Args&&... args) {
+    if (size_ < records_.size()) {
+      Overwrite(0, records_[size_], std::forward<Args>(args)...);
+    } else {
+      records_.reserve(records_.size() + 1);
+      records_.emplace_back(::new (arena_.Allocate(sizeof(T), alignof(T))) T(
+          std::forward<Args>(args)...));
+    }
+    ++size_;
+  }
+
+  template<class U, class... Args>
+  auto Overwrite(int, U* record, Args&&... args)
+      -> decltype(record->Assign(std::forward<Args>(args)...), void()) {
+    record->Assign(std::forward<Args>(args)...);
+  }
+
+  template<class U, class... Args>
+  void Overwrite(long, U* record, Args&&... args) {  // NOLINT
+    record->~T();
+    try {
+      ::new (record) T(std::forward<Args>(args)...);
+    } catch (...) {
+      records_.erase(records_.begin() + size_);
+      throw;
+    }
+  }
+
+  Arena arena_;
+  std::vector<T*> records_;  // [0, size_) hold the current batch
+  std::size_t size_;
+};
+
+}  // namespace bioparser
+
+#endif  // BIOPARSER_BATCH_HPP_
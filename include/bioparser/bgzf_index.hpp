@@ -0,0 +1,112 @@
+// Copyright (c) 2026 Robert Vaser
+
+#ifndef BIOPARSER_BGZF_INDEX_HPP_
+#define BIOPARSER_BGZF_INDEX_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bioparser {
+
+// offsets of BGZF blocks in the compressed and decompressed file, stored in
+// the .gzi format of bgzip (number of blocks followed by pairs of
+// little-endian 64-bit offsets, the first block is left out)
+class BgzfIndex {
+ public:
+  BgzfIndex()
+      : blocks_() {}
+
+  // returns nullptr if the file does not exist
+  static std::unique_ptr<BgzfIndex> Load(const std::string& path) {
+    std::unique_ptr<std::FILE, int(*)(std::FILE*)> file(
+        std::fopen(path.c_str(), "rb"), std::fclose);
+    if (!file) {
+      return nullptr;
+    }
+    std::unique_ptr<BgzfIndex> index(new BgzfIndex());
+    std::uint8_t buffer[16];
+    if (std::fread(buffer, 1, 8, file.get()) != 8) {
+      throw std::invalid_argument(
+          "[bioparser::BgzfIndex::Load] error: invalid file format");
+    }
+    auto num_blocks = Unpack(buffer);
+    for (std::uint64_t i = 0; i < num_blocks; ++i) {
+      if (std::fread(buffer, 1, 16, file.get()) != 16) {
+        throw std::invalid_argument(
+            "[bioparser::BgzfIndex::Load] error: invalid file format");
+      }
+      index->Add(Unpack(buffer), Unpack(buffer + 8));
+    }
+    return index;
+  }
+
+  void Store(const std::string& path) const {
+    std::vector<std::uint8_t> dst(8 + 16 * blocks_.size());
+    Pack(blocks_.size(), dst.data());
+    for (std::uint64_t i = 0; i < blocks_.size(); ++i) {
+      Pack(blocks_[i].first, &dst[8 + 16 * i]);
+      Pack(blocks_[i].second, &dst[16 + 16 * i]);
+    }
+    std::unique_ptr<std::FILE, int(*)(std::FILE*)> file(
+        std::fopen(path.c_str(), "wb"), std::fclose);
+    if (!file || std::fwrite(dst.data(), 1, dst.size(), file.get()) != dst.size()) {  // NOLINT
+      throw std::invalid_argument(
+          "[bioparser::BgzfIndex::Store] error: unable to write file " + path);
+    }
+  }
+
+  // blocks have to be added in file order
+  void Add(std::uint64_t compressed_offset, std::uint64_t offset) {
+    if (!blocks_.empty() && (compressed_offset <= blocks_.back().first ||
+        offset < blocks_.back().second)) {
+      throw std::invalid_argument(
+          "[bioparser::BgzfIndex::Add] error: blocks out of order");
+    }
+    blocks_.emplace_back(compressed_offset, offset);
+  }
+
+  // returns the compressed and decompressed offset of the block holding the
+  // given offset of decompressed bytes
+  std::pair<std::uint64_t, std::uint64_t> Locate(std::uint64_t offset) const {
+    auto it = std::upper_bound(
+        blocks_.begin(), blocks_.end(), offset,
+        [] (std::uint64_t lhs, const std::pair<std::uint64_t, std::uint64_t>& rhs) -> bool {  // NOLINT
+          return lhs < rhs.second;
+        });
+    if (it == blocks_.begin()) {
+      return std::make_pair(0, 0);
+    }
+    return *(--it);
+  }
+
+  std::uint64_t num_blocks() const {
+    return blocks_.size() + 1;
+  }
+
+ private:
+  static std::uint64_t Unpack(const std::uint8_t* src) {
+    std::uint64_t dst = 0;
+    for (std::uint32_t i = 0; i < 8; ++i) {
+      dst |= static_cast<std::uint64_t>(src[i]) << (8 * i);
+    }
+    return dst;
+  }
+
+  static void Pack(std::uint64_t src, std::uint8_t* dst) {
+    for (std::uint32_t i = 0; i < 8; ++i) {
+      dst[i] = static_cast<std::uint8_t>(src >> (8 * i));
+    }
+  }
+
+  std::vector<std::pair<std::uint64_t, std::uint64_t>> blocks_;
+};
+
+}  // namespace bioparser
+
+#endif  // BIOPARSER_BGZF_INDEX_HPP_
@@ -0,0 +1,389 @@
+// Copyright (c) 2026 Robert Vaser
+
+#ifndef BIOPARSER_BGZF_READER_HPP_
+#define BIOPARSER_BGZF_READER_HPP_
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "bioparser/bgzf_index.hpp"
+#include "bioparser/block_inflater.hpp"
+#include "bioparser/reader.hpp"
+
+namespace bioparser {
+
+// inflates blocks of BGZF files (series of gzip members carrying their
+// compressed size in the BC extra subfield) on a pool of worker threads, while
+// blocks are handed out in the original order
+class BgzfReader: public Reader {
+ public:
+  BgzfReader(std::FILE* file, std::uint32_t num_threads)
+      : file_(file, std::fclose),
+        batches_(2),
+        current_(&batches_[0]),
+        pending_(&batches_[1]),
+        max_blocks_(8 * std::max(num_threads, 1U)),
+        job_(nullptr),
+        next_block_(0),
+        num_done_blocks_(0),
+        is_corrupted_(false),
+        is_stopped_(false),
+        mutex_(),
+        cv_(),
+        done_cv_(),
+        workers_(),
+        path_(),
+        index_() {
+    Load(pending_);
+    for (std::uint32_t i = 0; i < std::max(num_threads, 1U); ++i) {
+      workers_.emplace_back(&BgzfReader::Work, this);
+    }
+    Dispatch(pending_);
+  }
+
+  BgzfReader(const BgzfReader&) = delete;
+  BgzfReader& operator=(const BgzfReader&) = delete;
+
+  BgzfReader(BgzfReader&&) = delete;
+  BgzfReader& operator=(BgzfReader&&) = delete;
+
+  ~BgzfReader() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      is_stopped_ = true;
+    }
+    cv_.notify_all();
+    for (auto& it : workers_) {
+      it.join();
+    }
+  }
+
+  // returns nullptr if the file is not BGZF compressed
+  static std::unique_ptr<Reader> Open(
+      const std::string& path,
+      std::uint32_t num_threads) {
+    auto file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+      return nullptr;
+    }
+    std::uint8_t header[18];
+    if (std::fread(header, 1, 18, file) != 18 || !IsBgzf(header)) {
+      std::fclose(file);
+      return nullptr;
+    }
+    std::rewind(file);
+    std::unique_ptr<BgzfReader> reader(new BgzfReader(file, num_threads));
+    reader->path_ = path;
+    return std::unique_ptr<Reader>(reader.release());
+  }
+
+  // walks over block headers of a BGZF file, the index can be stored next to
+  // it as path.gzi
+  static std::unique_ptr<BgzfIndex> Index(const std::string& path) {
+    std::unique_ptr<std::FILE, int(*)(std::FILE*)> file(
+        std::fopen(path.c_str(), "rb"), std::fclose);
+    if (!file) {
+      throw std::invalid_argument(
+          "[bioparser::BgzfReader::Index] error: unable to open file " + path);
+    }
+    return Index(file.get());
+  }
+
+  std::uint32_t Read(char* dst, std::uint32_t size) override {
+    std::uint32_t bytes = 0;
+    while (bytes < size) {
+      if (current_->data_ptr == current_->data_bytes) {
+        if (current_->is_eof) {
+          break;
+        }
+        Next();
+        continue;
+      }
+      auto count = std::min<std::uint64_t>(
+          size - bytes,
+          current_->data_bytes - current_->data_ptr);
+      std::memcpy(dst + bytes, &current_->data[current_->data_ptr], count);
+      current_->data_ptr += count;
+      bytes += count;
+    }
+    return bytes;
+  }
+
+  void Rewind() override {
+    Wait();
+    std::rewind(file_.get());
+    current_->Clear();
+    Load(pending_);
+    Dispatch(pending_);
+  }
+
+  // starts inflating at the block holding offset, located through path.gzi,
+  // or an index built on the first call if the file does not exist
+  void Seek(std::uint64_t offset) override {
+    Wait();
+    if (!index_) {
+      index_ = BgzfIndex::Load(path_ + ".gzi");
+      if (!index_) {
+        index_ = Index(file_.get());
+      }
+    }
+    auto block = index_->Locate(offset);
+    if (std::fseek(file_.get(), block.first, SEEK_SET) != 0) {
+      throw std::invalid_argument(
+          "[bioparser::BgzfReader] error: unable to seek");
+    }
+    current_->Clear();
+    Load(pending_);
+    Dispatch(pending_);
+
+    for (auto skip = offset - block.second; skip > 0;) {
+      if (current_->data_ptr == current_->data_bytes) {
+        if (current_->is_eof) {
+          break;
+        }
+        Next();
+        continue;
+      }
+      auto count = std::min<std::uint64_t>(
+          skip,
+          current_->data_bytes - current_->data_ptr);
+      current_->data_ptr += count;
+      skip -= count;
+    }
+  }
+
+ private:
+  struct Block {
+    std::uint64_t src_ptr;  // deflate stream in Batch::src
+    std::uint32_t src_len;
+    std::uint64_t data_ptr;  // inflated block in Batch::data
+    std::uint32_t data_len;
+    std::uint32_t crc;
+  };
+
+  struct Batch {
+    void Clear() {
+      src.clear();
+      blocks.clear();
+      data_bytes = 0;
+      data_ptr = 0;
+      is_eof = false;
+    }
+
+    std::vector<char> src;
+    std::vector<Block> blocks;
+    std::vector<char> data;
+    std::uint64_t data_bytes = 0;
+    std::uint64_t data_ptr = 0;
+    bool is_eof = false;
+  };
+
+  static std::uint32_t Unpack(const std::uint8_t* src, std::uint32_t len) {
+    std::uint32_t dst = 0;
+    for (std::uint32_t i = 0; i < len; ++i) {
+      dst |= static_cast<std::uint32_t>(src[i]) << (8 * i);
+    }
+    return dst;
+  }
+
+  // locates BSIZE (total block size - 1) among the extra subfields
+  static bool FindBlockSize(
+      const std::uint8_t* extra, std::uint32_t extra_len,
+      std::uint32_t* block_size) {
+    for (std::uint32_t i = 0; i + 4 <= extra_len;) {
+      auto subfield_len = Unpack(extra + i + 2, 2);
+      if (extra[i] == 'B' && extra[i + 1] == 'C' && subfield_len == 2 &&
+          i + 6 <= extra_len) {
+        *block_size = Unpack(extra + i + 4, 2) + 1;
+        return true;
+      }
+      i += 4 + subfield_len;
+    }
+    return false;
+  }
+
+  static bool IsBgzf(const std::uint8_t* header) {  // first 18 bytes
+    std::uint32_t block_size = 0;
+    return header[0] == 31 && header[1] == 139 && header[2] == 8 &&
+        (header[3] & 4) &&
+        FindBlockSize(header + 12, std::min(Unpack(header + 10, 2), 6U),
+            &block_size);
+  }
+
+  // reads the header of the next block and returns the size of the block and
+  // of its header, or false at the end of file
+  static bool ReadHeader(
+      std::FILE* file,
+      std::vector<std::uint8_t>* extra,
+      std::uint32_t* block_size,
+      std::uint32_t* header_size) {
+    std::uint8_t header[12];
+    auto header_len = std::fread(header, 1, 12, file);
+    if (header_len == 0) {
+      return false;
+    }
+    auto extra_len = Unpack(header + 10, 2);
+    extra->resize(extra_len);
+    if (header_len != 12 || header[0] != 31 || header[1] != 139 ||
+        header[2] != 8 || !(header[3] & 4) ||
+        std::fread(extra->data(), 1, extra_len, file) != extra_len ||
+        !FindBlockSize(extra->data(), extra_len, block_size) ||
+        *block_size < 12 + extra_len + 8) {
+      throw std::invalid_argument(
+          "[bioparser::BgzfReader] error: invalid file format");
+    }
+    *header_size = 12 + extra_len;
+    return true;
+  }
+
+  static std::unique_ptr<BgzfIndex> Index(std::FILE* file) {
+    std::rewind(file);
+    std::unique_ptr<BgzfIndex> index(new BgzfIndex());
+    std::uint64_t compressed_offset = 0;
+    std::uint64_t offset = 0;
+    std::vector<std::uint8_t> extra;
+    std::uint32_t block_size = 0;
+    std::uint32_t header_size = 0;
+    while (ReadHeader(file, &extra, &block_size, &header_size)) {
+      std::uint8_t footer[4];  // ISIZE
+      if (std::fseek(file, block_size - header_size - 4, SEEK_CUR) != 0 ||
+          std::fread(footer, 1, 4, file) != 4) {
+        throw std::invalid_argument(
+            "[bioparser::BgzfReader] error: invalid file format");
+      }
+      auto data_len = Unpack(footer, 4);
+      if (compressed_offset > 0 && data_len > 0) {
+        index->Add(compressed_offset, offset);
+      }
+      compressed_offset += block_size;
+      offset += data_len;
+    }
+    return index;
+  }
+
+  // reads up to max_blocks_ compressed blocks on the calling thread
+  void Load(Batch* batch) {
+    batch->Clear();
+    std::vector<std::uint8_t> extra;
+    std::uint32_t block_size = 0;
+    std::uint32_t header_size = 0;
+    while (batch->blocks.size() < max_blocks_) {
+      if (!ReadHeader(file_.get(), &extra, &block_size, &header_size)) {
+        batch->is_eof = true;
+        break;
+      }
+
+      Block block;
+      block.src_ptr = batch->src.size();
+      block.src_len = block_size - header_size - 8;
+      batch->src.resize(batch->src.size() + block.src_len + 8);
+      if (std::fread(&batch->src[block.src_ptr], 1, block.src_len + 8, file_.get()) !=  // NOLINT
+          block.src_len + 8) {
+        throw std::invalid_argument(
+            "[bioparser::BgzfReader] error: invalid file format");
+      }
+      auto footer = reinterpret_cast<const std::uint8_t*>(
+          &batch->src[block.src_ptr + block.src_len]);
+      block.crc = Unpack(footer, 4);
+      block.data_len = Unpack(footer + 4, 4);
+      block.data_ptr = batch->data_bytes;
+      batch->data_bytes += block.data_len;
+      batch->blocks.emplace_back(block);
+    }
+    if (batch->data.size() < batch->data_bytes) {
+      batch->data.resize(batch->data_bytes);
+    }
+  }
+
+  void Dispatch(Batch* batch) {
+    if (batch->blocks.empty()) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    job_ = batch;
+    next_block_ = 0;
+    num_done_blocks_ = 0;
+    cv_.notify_all();
+  }
+
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [&] () { return job_ == nullptr; });
+    if (is_corrupted_) {
+      throw std::invalid_argument(
+          "[bioparser::BgzfReader] error: invalid file format");
+    }
+  }
+
+  // hands out the inflated batch and starts on the following one
+  void Next() {
+    Wait();
+    std::swap(current_, pending_);
+    if (!current_->is_eof) {
+      Load(pending_);
+      Dispatch(pending_);
+    }
+  }
+
+  void Work() {
+    BlockInflater inflater;
+
+    while (true) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [&] () {
+        return is_stopped_ ||
+            (job_ != nullptr && next_block_ < job_->blocks.size());
+      });
+      if (is_stopped_) {
+        break;
+      }
+      auto batch = job_;
+      auto i = next_block_++;
+      lock.unlock();
+
+      const auto& block = batch->blocks[i];
+      bool is_inflated = inflater.Inflate(
+          batch->src.data() + block.src_ptr, block.src_len,
+          batch->data.data() + block.data_ptr, block.data_len,
+          block.crc);
+
+      lock.lock();
+      is_corrupted_ |= !is_inflated;
+      if (++num_done_blocks_ == batch->blocks.size()) {
+        job_ = nullptr;
+        done_cv_.notify_all();
+      }
+    }
+  }
+
+  std::unique_ptr<std::FILE, int(*)(std::FILE*)> file_;
+  std::vector<Batch> batches_;
+  Batch* current_;  // being read
+  Batch* pending_;  // being inflated
+  std::uint32_t max_blocks_;  // per batch
+  Batch* job_;
+  std::uint32_t next_block_;
+  std::uint32_t num_done_blocks_;
+  bool is_corrupted_;
+  bool is_stopped_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::condition_variable done_cv_;
+  std::vector<std::thread> workers_;
+  std::string path_;
+  std::unique_ptr<BgzfIndex> index_;  // built on the first Seek()
+};
+
+}  // namespace bioparser
+
+#endif  // BIOPARSER_BGZF_READER_HPP_
@@ -0,0 +1,116 @@
+// Copyright (c) 2026 Robert Vaser
+
+#ifndef BIOPARSER_BLOCK_INFLATER_HPP_
+#define BIOPARSER_BLOCK_INFLATER_HPP_
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include "zlib.h"  // NOLINT
+
+#if defined(BIOPARSER_USE_LIBDEFLATE)
+#include "libdeflate.h"  // NOLINT
+#endif
+
+namespace bioparser {
+
+// inflates whole raw deflate streams of known size (e.g. BGZF blocks) and
+// verifies their crc32; libdeflate decodes a block in one pass without the
+// bookkeeping of streaming and is used if BIOPARSER_USE_LIBDEFLATE is defined
+// (bioparser_use_libdeflate in CMake, libdeflate in Meson); one per thread
+class BlockInflater {
+ public:
+  enum class Backend {
+    kZlib,  // or zlib-ng, if bioparser is linked against its compat library
+    kLibdeflate
+  };
+
+  explicit BlockInflater(Backend backend = Default())
+      : backend_(backend),
+        strm_(),
+        is_valid_(false) {
+    if (backend_ == Backend::kLibdeflate) {
+#if defined(BIOPARSER_USE_LIBDEFLATE)
+      decompressor_ = libdeflate_alloc_decompressor();
+      is_valid_ = decompressor_ != nullptr;
+#else
+      throw std::invalid_argument(
+          "[bioparser::BlockInflater] error: libdeflate support is not enabled");  // NOLINT
+#endif
+    } else {
+      std::memset(&strm_, 0, sizeof(strm_));
+      is_valid_ = inflateInit2(&strm_, -15) == Z_OK;  // raw deflate
+    }
+  }
+
+  BlockInflater(const BlockInflater&) = delete;
+  BlockInflater& operator=(const BlockInflater&) = delete;
+
+  BlockInflater(BlockInflater&&) = delete;
+  BlockInflater& operator=(BlockInflater&&) = delete;
+
+  ~BlockInflater() {
+    if (!is_valid_) {
+      return;
+    }
+#if defined(BIOPARSER_USE_LIBDEFLATE)
+    if (backend_ == Backend::kLibdeflate) {
+      libdeflate_free_decompressor(decompressor_);
+      return;
+    }
+#endif
+    inflateEnd(&strm_);
+  }
+
+  static Backend Default() {
+#if defined(BIOPARSER_USE_LIBDEFLATE)
+    return Backend::kLibdeflate;
+#else
+    return Backend::kZlib;
+#endif
+  }
+
+  // returns false if src does not inflate to exactly dst_len bytes with the
+  // given crc32
+  bool Inflate(
+      const char* src, std::uint32_t src_len,
+      char* dst, std::uint32_t dst_len,
+      std::uint32_t crc) {
+    if (!is_valid_) {
+      return false;
+    }
+#if defined(BIOPARSER_USE_LIBDEFLATE)
+    if (backend_ == Backend::kLibdeflate) {
+      return libdeflate_deflate_decompress(
+          decompressor_, src, src_len, dst, dst_len, nullptr) == LIBDEFLATE_SUCCESS &&  // NOLINT
+          libdeflate_crc32(0, dst, dst_len) == crc;
+    }
+#endif
+    if (inflateReset(&strm_) != Z_OK) {
+      return false;
+    }
+    Bytef sink;  // zlib rejects null output even if there is nothing to write
+    auto data = dst_len == 0 ? &sink : reinterpret_cast<Bytef*>(dst);
+    strm_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(src));
+    strm_.avail_in = src_len;
+    strm_.next_out = data;
+    strm_.avail_out = dst_len;
+    if (inflate(&strm_, Z_FINISH) != Z_STREAM_END || strm_.avail_out != 0) {
+      return false;
+    }
+    return crc32(crc32(0, Z_NULL, 0), data, dst_len) == crc;
+  }
+
+ private:
+  Backend backend_;
+  z_stream strm_;
+#if defined(BIOPARSER_USE_LIBDEFLATE)
+  libdeflate_decompressor* decompressor_ = nullptr;
+#endif
+  bool is_valid_;
+};
+
+}  // namespace bioparser
+
+#endif  // BIOPARSER_BLOCK_INFLATER_HPP_
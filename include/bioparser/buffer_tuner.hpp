@@ -0,0 +1,132 @@
+// Copyright (c) 2026 Robert Vaser
+
+#ifndef BIOPARSER_BUFFER_TUNER_HPP_
+#define BIOPARSER_BUFFER_TUNER_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+namespace bioparser {
+
+// picks the size of reads from observed record sizes and throughput: reads
+// grow until records fit into a single one (so that they are not copied), and
+// double while each doubling speeds up parsing by at least 10 % (e.g. on
+// network filesystems where reads are dominated by latency); a doubling
+// which slows parsing down is undone and probing stops
+class BufferTuner {
+ public:
+  BufferTuner(std::uint32_t size, std::uint32_t max_size)
+      : size_(std::min(size, max_size)),
+        previous_size_(size_),
+        max_size_(max_size),
+        rate_(0),
+        is_settled_(false),
+        num_reads_(0),
+        window_bytes_(0),
+        window_seconds_(0),
+        max_record_size_(0),
+        storage_size_(kMinStorageSize),
+        last_tick_(),
+        is_ticking_(false) {}
+
+  // of the next read
+  std::uint32_t size() const {
+    return size_;
+  }
+
+  // capacity of the storage worth keeping for the records of the last window
+  std::uint64_t storage_size() const {
+    return storage_size_;
+  }
+
+  // a record of the given size was completed
+  void Observe(std::uint64_t record_size) {
+    max_record_size_ = std::max(max_record_size_, record_size);
+  }
+
+  // measures the time since the previous call, which covers reading and
+  // parsing the previous bytes (of a read which filled the buffer); returns
+  // true if size() changed
+  bool Tick(std::uint64_t bytes) {
+    auto now = std::chrono::steady_clock::now();
+    auto is_ticking = is_ticking_;
+    auto last_tick = last_tick_;
+    last_tick_ = now;
+    is_ticking_ = true;
+    if (!is_ticking) {
+      return false;
+    }
+    return Update(
+        bytes,
+        std::chrono::duration<double>(now - last_tick).count());
+  }
+
+  // forgets the previous tick, e.g. while the caller is processing records
+  void Pause() {
+    is_ticking_ = false;
+  }
+
+  // bytes were read and parsed in seconds; returns true if size() changed
+  bool Update(std::uint64_t bytes, double seconds) {
+    window_bytes_ += bytes;
+    window_seconds_ += seconds;
+    if (++num_reads_ < kWindowSize) {
+      return false;
+    }
+
+    auto size = size_;
+    auto rate = window_seconds_ > 0 ? window_bytes_ / window_seconds_ : 0;
+    if (2 * max_record_size_ > size_) {  // records span reads
+      while (size_ < max_size_ && 2 * max_record_size_ > size_) {
+        size_ = std::min<std::uint64_t>(2ULL * size_, max_size_);
+      }
+      rate_ = 0;  // throughput of the new size is measured from scratch
+    } else if (!is_settled_) {
+      if (rate_ == 0 || rate > 1.1 * rate_) {
+        rate_ = rate;
+        if (size_ < max_size_) {
+          previous_size_ = size_;
+          size_ = std::min<std::uint64_t>(2ULL * size_, max_size_);
+        } else {
+          is_settled_ = true;
+        }
+      } else {
+        if (rate < 0.9 * rate_) {
+          size_ = previous_size_;
+        }
+        is_settled_ = true;
+      }
+    }
+    storage_size_ = 2 * max_record_size_ > kMinStorageSize ?
+        2 * max_record_size_ :
+        kMinStorageSize;
+
+    num_reads_ = 0;
+    window_bytes_ = 0;
+    window_seconds_ = 0;
+    max_record_size_ = 0;
+    return size != size_;
+  }
+
+ private:
+  static constexpr std::uint32_t kWindowSize = 8;  // reads
+  static constexpr std::uint64_t kMinStorageSize = 1U << 16;  // 64 kB
+
+  std::uint32_t size_;
+  std::uint32_t previous_size_;  // before the last doubling
+  std::uint32_t max_size_;
+  double rate_;  // bytes per second of the previous size
+  bool is_settled_;
+  std::uint32_t num_reads_;
+  std::uint64_t window_bytes_;
+  double window_seconds_;
+  std::uint64_t max_record_size_;
+  std::uint64_t storage_size_;
+  std::chrono::steady_clock::time_point last_tick_;
+  bool is_ticking_;
+};
+
+}  // namespace bioparser
+
+#endif  // BIOPARSER_BUFFER_TUNER_HPP_
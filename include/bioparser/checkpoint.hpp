@@ -0,0 +1,94 @@
+// Copyright (c) 2026 Robert Vaser
+
+#ifndef BIOPARSER_CHECKPOINT_HPP_
+#define BIOPARSER_CHECKPOINT_HPP_
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "bioparser/inflate_reader.hpp"
+
+namespace bioparser {
+
+// record boundary of a file from which parsing can be resumed, also by
+// another parser of the same file (see Parser::Save() and Parser::Restore())
+struct Checkpoint {
+  // returns nullptr if the file does not exist
+  static std::unique_ptr<Checkpoint> Load(const std::string& path) {
+    std::unique_ptr<std::FILE, int(*)(std::FILE*)> file(
+        std::fopen(path.c_str(), "rb"), std::fclose);
+    if (!file) {
+      return nullptr;
+    }
+    std::unique_ptr<Checkpoint> checkpoint(new Checkpoint());
+    std::uint8_t buffer[48];
+    std::uint64_t window_len = 0;
+    if (std::fread(buffer, 1, 48, file.get()) != 48 ||
+        std::memcmp(buffer, Magic(), 8) != 0 ||
+        Unpack(buffer + 24) > 7 ||
+        (window_len = Unpack(buffer + 40)) > 32768) {
+      throw std::invalid_argument(
+          "[bioparser::Checkpoint::Load] error: invalid file format");
+    }
+    checkpoint->offset = Unpack(buffer + 8);
+    checkpoint->point.compressed_offset = Unpack(buffer + 16);
+    checkpoint->point.bits = Unpack(buffer + 24);
+    checkpoint->point.offset = Unpack(buffer + 32);
+    checkpoint->point.window.resize(window_len);
+    if (std::fread(checkpoint->point.window.data(), 1, window_len, file.get()) != window_len ||  // NOLINT
+        checkpoint->point.offset > checkpoint->offset) {
+      throw std::invalid_argument(
+          "[bioparser::Checkpoint::Load] error: invalid file format");
+    }
+    return checkpoint;
+  }
+
+  void Store(const std::string& path) const {
+    std::vector<std::uint8_t> dst(48 + point.window.size());
+    std::memcpy(dst.data(), Magic(), 8);
+    Pack(offset, &dst[8]);
+    Pack(point.compressed_offset, &dst[16]);
+    Pack(point.bits, &dst[24]);
+    Pack(point.offset, &dst[32]);
+    Pack(point.window.size(), &dst[40]);
+    std::memcpy(&dst[48], point.window.data(), point.window.size());
+
+    std::unique_ptr<std::FILE, int(*)(std::FILE*)> file(
+        std::fopen(path.c_str(), "wb"), std::fclose);
+    if (!file || std::fwrite(dst.data(), 1, dst.size(), file.get()) != dst.size()) {  // NOLINT
+      throw std::invalid_argument(
+          "[bioparser::Checkpoint::Store] error: unable to write file " + path);
+    }
+  }
+
+  std::uint64_t offset = 0;  // of the next record in decompressed bytes
+  AccessPoint point;  // in front of offset, gzip compressed files only
+
+ private:
+  static std::uint64_t Unpack(const std::uint8_t* src) {
+    std::uint64_t dst = 0;
+    for (std::uint32_t i = 0; i < 8; ++i) {
+      dst |= static_cast<std::uint64_t>(src[i]) << (8 * i);
+    }
+    return dst;
+  }
+
+  static void Pack(std::uint64_t src, std::uint8_t* dst) {
+    for (std::uint32_t i = 0; i < 8; ++i) {
+      dst[i] = static_cast<std::uint8_t>(src >> (8 * i));
+    }
+  }
+
+  static const char* Magic() {
+    return "BIOPCKP1";
+  }
+};
+
+}  // namespace bioparser
+
+#endif  // BIOPARSER_CHECKPOINT_HPP_
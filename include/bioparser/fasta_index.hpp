@@ -0,0 +1,270 @@
+// Copyright (c) 2026 Robert Vaser
+
+#ifndef BIOPARSER_FASTA_INDEX_HPP_
+#define BIOPARSER_FASTA_INDEX_HPP_
+
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "zlib.h"  // NOLINT
+
+#include "bioparser/mmap_reader.hpp"
+#include "bioparser/numeric.hpp"
+#include "bioparser/reader.hpp"
+#include "bioparser/scanner.hpp"
+
+namespace bioparser {
+
+// samtools compatible index of a FASTA file (.fai), which locates sequences
+// by the offset of their first base in the decompressed file and the layout
+// of their lines
+class FastaIndex {
+ public:
+  struct Entry {
+    // returns the offset of the base at pos in the decompressed file
+    std::uint64_t Offset(std::uint64_t pos) const {
+      if (line_bases == 0) {
+        return offset;
+      }
+      return offset + pos / line_bases * line_width + pos % line_bases;
+    }
+
+    std::string name;
+    std::uint64_t length;  // in bases
+    std::uint64_t offset;
+    std::uint64_t line_bases;
+    std::uint64_t line_width;  // including the line ending
+  };
+
+  FastaIndex()
+      : entries_(),
+        ids_() {}
+
+  // scans a FASTA file, which can be compressed; all lines of a sequence
+  // except for the last one have to be of equal length
+  static std::unique_ptr<FastaIndex> Build(const std::string& path) {
+    auto reader = MmapReader::Open(path);
+    if (!reader) {
+      auto file = gzopen(path.c_str(), "r");
+      if (file == nullptr) {
+        throw std::invalid_argument(
+            "[bioparser::FastaIndex::Build] error: unable to open file " +
+            path);
+      }
+      reader.reset(new GzReader(file));
+    }
+
+    std::unique_ptr<FastaIndex> index(new FastaIndex());
+    Entry entry{};
+    bool has_entry = false;
+    bool is_header = false;
+    bool is_name = false;
+    bool is_last = false;  // a shorter line ends the sequence
+    std::uint64_t line_len = 0;
+    char last = 0;  // of the current line
+
+    auto end_line = [&] (std::uint64_t bases, std::uint64_t width) -> void {
+      if (bases == 0) {
+        if (entry.length == 0) {
+          entry.offset += width;
+        } else {
+          is_last = true;
+        }
+        return;
+      }
+      if (!has_entry) {
+        throw std::invalid_argument(
+            "[bioparser::FastaIndex::Build] error: invalid file format");
+      }
+      if (is_last || (entry.line_bases > 0 && (bases > entry.line_bases ||
+          width - bases != entry.line_width - entry.line_bases))) {
+        throw std::invalid_argument(
+            "[bioparser::FastaIndex::Build] error: different line lengths in "
+            "sequence " + entry.name);
+      }
+      if (entry.line_bases == 0) {
+        entry.line_bases = bases;
+        entry.line_width = width;
+      } else if (bases < entry.line_bases) {
+        is_last = true;
+      }
+      entry.length += bases;
+    };
+
+    std::vector<char> buffer(65536);  // 64 kB
+    std::uint64_t offset = 0;  // of buffer[0]
+    while (true) {
+      auto bytes = reader->Read(buffer.data(), buffer.size());
+      auto data = buffer.data();
+      for (std::uint64_t i = 0; i < bytes;) {
+        auto j = static_cast<std::uint64_t>(
+            Scanner::FindFirstOf(data + i, data + bytes, '\n', '\n') - data);
+        if (is_header) {
+          for (; is_name && i < j; ++i) {
+            if (std::isspace(static_cast<unsigned char>(data[i]))) {
+              is_name = false;
+            } else {
+              entry.name.push_back(data[i]);
+            }
+          }
+          if (j < bytes) {
+            is_header = false;
+            entry.offset = offset + j + 1;
+          }
+        } else if (line_len == 0 && data[i] == '>') {
+          if (has_entry) {
+            index->Add(std::move(entry));
+          }
+          entry = Entry{};
+          has_entry = true;
+          is_header = true;
+          is_name = true;
+          is_last = false;
+          ++i;
+          continue;
+        } else {
+          line_len += j - i;
+          if (j > i) {
+            last = data[j - 1];
+          }
+          if (j < bytes) {
+            end_line(line_len - (line_len > 0 && last == '\r'), line_len + 1);
+            line_len = 0;
+          }
+        }
+        i = j + 1;
+      }
+      offset += bytes;
+      if (bytes < buffer.size()) {
+        break;
+      }
+    }
+    if (line_len > 0) {  // missing line ending
+      auto bases = line_len - (last == '\r');
+      end_line(bases, line_len + 1);
+    }
+    if (has_entry) {
+      index->Add(std::move(entry));
+    }
+    return index;
+  }
+
+  // returns nullptr if the file does not exist
+  static std::unique_ptr<FastaIndex> Load(const std::string& path) {
+    std::unique_ptr<std::FILE, int(*)(std::FILE*)> file(
+        std::fopen(path.c_str(), "rb"), std::fclose);
+    if (!file) {
+      return nullptr;
+    }
+    std::string src;
+    char buffer[65536];
+    std::size_t bytes = 0;
+    while ((bytes = std::fread(buffer, 1, sizeof(buffer), file.get())) > 0) {
+      src.append(buffer, bytes);
+    }
+
+    std::unique_ptr<FastaIndex> index(new FastaIndex());
+    auto first = src.data();
+    auto last = src.data() + src.size();
+    while (first < last) {
+      auto end = Scanner::FindFirstOf(first, last, '\n', '\n');
+      if (end > first && end[-1] == '\r') {
+        --end;
+      }
+      if (end == first) {
+        first = Scanner::FindFirstOf(first, last, '\n', '\n') + 1;
+        continue;
+      }
+
+      const char* fields[6];  // FASTQ indices carry a sixth column
+      std::uint32_t num_fields = 0;
+      for (auto it = first; num_fields < 6;) {
+        fields[num_fields++] = it;
+        it = Scanner::FindFirstOf(it, end, '\t', '\t');
+        if (it == end) {
+          break;
+        }
+        ++it;
+      }
+
+      Entry entry{};
+      bool is_valid = num_fields >= 5 && fields[1] - fields[0] > 1;
+      if (is_valid) {
+        entry.name.assign(fields[0], fields[1] - 1);
+        is_valid &= Numeric::Parse(fields[1], fields[2] - 1, &entry.length);
+        is_valid &= Numeric::Parse(fields[2], fields[3] - 1, &entry.offset);
+        is_valid &= Numeric::Parse(
+            fields[3], fields[4] - 1, &entry.line_bases);
+        is_valid &= Numeric::Parse(
+            fields[4],
+            num_fields == 5 ? end : fields[5] - 1,
+            &entry.line_width);
+        is_valid &= entry.line_bases <= entry.line_width;
+      }
+      if (!is_valid) {
+        throw std::invalid_argument(
+            "[bioparser::FastaIndex::Load] error: invalid file format");
+      }
+      index->Add(std::move(entry));
+
+      first = Scanner::FindFirstOf(end, last, '\n', '\n') + 1;
+    }
+    return index;
+  }
+
+  void Store(const std::string& path) const {
+    std::string dst;
+    for (const auto& it : entries_) {
+      dst += it.name + '\t' +
+          std::to_string(it.length) + '\t' +
+          std::to_string(it.offset) + '\t' +
+          std::to_string(it.line_bases) + '\t' +
+          std::to_string(it.line_width) + '\n';
+    }
+    std::unique_ptr<std::FILE, int(*)(std::FILE*)> file(
+        std::fopen(path.c_str(), "wb"), std::fclose);
+    if (!file || std::fwrite(dst.data(), 1, dst.size(), file.get()) != dst.size()) {  // NOLINT
+      throw std::invalid_argument(
+          "[bioparser::FastaIndex::Store] error: unable to write file " + path);
+    }
+  }
+
+  // ignores entries with a known name like samtools does, and returns
+  // whether the entry was added
+  bool Add(Entry entry) {
+    if (entry.name.empty()) {
+      throw std::invalid_argument(
+          "[bioparser::FastaIndex::Add] error: missing name");
+    }
+    if (!ids_.emplace(entry.name, entries_.size()).second) {
+      return false;
+    }
+    entries_.emplace_back(std::move(entry));
+    return true;
+  }
+
+  // returns nullptr for unknown names
+  const Entry* Find(const std::string& name) const {
+    auto it = ids_.find(name);
+    return it == ids_.end() ? nullptr : &entries_[it->second];
+  }
+
+  const std::vector<Entry>& entries() const {
+    return entries_;
+  }
+
+ private:
+  std::vector<Entry> entries_;
+  std::unordered_map<std::string, std::uint64_t> ids_;
+};
+
+}  // namespace bioparser
+
+#endif  // BIOPARSER_FASTA_INDEX_HPP_
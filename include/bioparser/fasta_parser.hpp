@@ -3,12 +3,14 @@
 #ifndef BIOPARSER_FASTA_PARSER_HPP_
 #define BIOPARSER_FASTA_PARSER_HPP_
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <vector>
 #include <stdexcept>
 #include <string>
 
+#include "bioparser/fasta_index.hpp"
 #include "bioparser/parser.hpp"
 
 namespace bioparser {
@@ -24,11 +26,92 @@ class FastaParser: public Parser<T> {
 
   ~FastaParser() {}
 
+  using Parser<T>::Parse;
+
   std::vector<std::unique_ptr<T>> Parse(
       std::uint64_t bytes, bool shorten_names = true) override {
-    std::vector<std::unique_ptr<T>> dst;
+    if (this->num_threads() > 1) {
+      return this->template ParseInParallel<FastaParser>(
+          bytes, shorten_names, &FastaParser::Resync);
+    }
+    return Parser<T>::Parse(bytes, shorten_names);
+  }
+
+  // end is clamped to the sequence length; sequences are located through
+  // path.fai, which is built in memory on the first call if it does not exist,
+  // and BGZF compressed files are inflated from the block holding begin,
+  // located through path.gzi (other gzip files are inflated from the start);
+  // does not interfere with Parse()
+  std::unique_ptr<T> Fetch(
+      const std::string& name,
+      std::uint64_t begin,
+      std::uint64_t end) override {
+    if (!index_) {
+      index_ = FastaIndex::Load(this->path() + ".fai");
+      if (!index_) {
+        index_ = FastaIndex::Build(this->path());
+      }
+    }
+    auto entry = index_->Find(name);
+    if (entry == nullptr) {
+      throw std::invalid_argument(
+          "[bioparser::FastaParser::Fetch] error: missing sequence " + name);
+    }
+    end = std::min(end, entry->length);
+    if (begin >= end) {
+      throw std::invalid_argument(
+          "[bioparser::FastaParser::Fetch] error: empty region");
+    }
+
+    if (!fetch_reader_) {
+      fetch_reader_ = MmapReader::Open(this->path());
+    }
+    if (!fetch_reader_) {
+      fetch_reader_ = BgzfReader::Open(this->path(), 1);
+    }
+    if (!fetch_reader_) {
+      auto file = gzopen(this->path().c_str(), "r");
+      if (file == nullptr) {
+        throw std::invalid_argument(
+            "[bioparser::FastaParser::Fetch] error: unable to open file " +
+            this->path());
+      }
+      fetch_reader_.reset(new GzReader(file));
+    }
+
+    auto first = entry->Offset(begin);
+    auto last = entry->Offset(end - 1) + 1;
+    fetch_buffer_.resize(last - first);
+    fetch_reader_->Seek(first);
+    for (std::uint64_t i = 0; i < fetch_buffer_.size();) {
+      auto bytes = fetch_reader_->Read(
+          &fetch_buffer_[i],
+          std::min<std::uint64_t>(fetch_buffer_.size() - i, 1U << 30));
+      if (bytes == 0) {
+        break;
+      }
+      i += bytes;
+    }
+    auto data_end = std::remove_if(
+        fetch_buffer_.begin(), fetch_buffer_.end(),
+        [] (char c) -> bool { return c == '\n' || c == '\r'; });
+    if (static_cast<std::uint64_t>(data_end - fetch_buffer_.begin()) !=
+        end - begin) {
+      throw std::invalid_argument(
+          "[bioparser::FastaParser::Fetch] error: invalid index");
+    }
+
+    return this->Construct(
+        name.c_str(), name.size(),
+        fetch_buffer_.data(), end - begin);
+  }
+
+ private:
+  std::uint64_t ParseRecords(
+      std::uint64_t bytes, bool shorten_names) override {
+    std::uint64_t num_records = 0;
     std::uint64_t parsed_bytes = 0;
-    std::uint32_t data_ptr = 0;
+    std::uint64_t data_ptr = 0;
 
     auto create_T = [&] () -> void {
       if (data_ptr == 0) {
@@ -36,20 +119,23 @@ class FastaParser: public Parser<T> {
             "[bioparser::FastaParser] error: invalid file format");
       }
 
+      auto name = this->Span(0, data_ptr);
       auto name_len = shorten_names ?
-          this->Shorten(this->storage().data(), data_ptr) :
-          this->RightStrip(this->storage().data(), data_ptr);
+          this->Shorten(name, data_ptr) :
+          this->RightStrip(name, data_ptr);
 
+      auto data = this->Span(data_ptr, this->storage_ptr());
       auto data_len = this->storage_ptr() - data_ptr;
 
-      if (name_len == 0 || this->storage()[0] != '>' || data_len == 0) {
+      if (name_len == 0 || name[0] != '>' || data_len == 0) {
         throw std::invalid_argument(
             "[bioparser::FastaParser] error: invalid file format");
       }
 
-      dst.emplace_back(std::unique_ptr<T>(new T(
-          static_cast<const char*>(this->storage().data() + 1), name_len - 1,
-          static_cast<const char*>(this->storage().data() + data_ptr), data_len)));  // NOLINT
+      this->Emit(
+          name + 1, name_len - 1,
+          data, data_len);
+      ++num_records;
 
       parsed_bytes += this->storage_ptr();
       data_ptr = 0;
@@ -62,6 +148,10 @@ class FastaParser: public Parser<T> {
     while (true) {
       auto buffer_ptr = this->buffer_ptr();
       for (; buffer_ptr < this->buffer_bytes(); ++buffer_ptr) {
+        buffer_ptr = this->Find(buffer_ptr, '\n', is_name ? '\n' : '>');
+        if (buffer_ptr == this->buffer_bytes()) {
+          break;
+        }
         auto c = this->buffer()[buffer_ptr];
         if (c == '\n') {
           this->Store(buffer_ptr - this->buffer_ptr(), !is_name);
@@ -73,7 +163,7 @@ class FastaParser: public Parser<T> {
           is_name = true;
           create_T();
           if (parsed_bytes >= bytes) {
-            return dst;
+            return num_records;
           }
         }
       }
@@ -91,14 +181,36 @@ class FastaParser: public Parser<T> {
       create_T();
     }
 
-    return dst;
+    return num_records;
   }
 
- private:
-  explicit FastaParser(gzFile file)
-      : Parser<T>(file, 4194304) {}  // 4 MB
+  explicit FastaParser(Reader* reader)
+      : Parser<T>(reader, 4194304),  // 4 MB
+        index_(),
+        fetch_reader_(),
+        fetch_buffer_() {}
+
+  // returns the first line starting with '>' at or after pos
+  static std::uint64_t Resync(
+      const char* data, std::uint64_t size,
+      std::uint64_t pos) {
+    if (pos == 0) {
+      return 0;
+    }
+    for (auto i = pos - 1; i + 1 < size; ++i) {
+      i = Scanner::FindFirstOf(data + i, data + size, '\n', '\n') - data;
+      if (i + 1 < size && data[i + 1] == '>') {
+        return i + 1;
+      }
+    }
+    return size;
+  }
 
   friend Parser<T>;
+
+  std::unique_ptr<FastaIndex> index_;
+  std::unique_ptr<Reader> fetch_reader_;  // independent of Parse()
+  std::vector<char> fetch_buffer_;
 };
 
 }  // namespace bioparser
@@ -3,6 +3,8 @@
 #ifndef BIOPARSER_FASTQ_PARSER_HPP_
 #define BIOPARSER_FASTQ_PARSER_HPP_
 
+#include <algorithm>
+#include <cctype>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -24,13 +26,25 @@ class FastqParser: public Parser<T> {
 
   ~FastqParser() {}
 
+  using Parser<T>::Parse;
+
   std::vector<std::unique_ptr<T>> Parse(
       std::uint64_t bytes, bool shorten_names = true) override {
-    std::vector<std::unique_ptr<T>> dst;
+    if (this->num_threads() > 1) {
+      return this->template ParseInParallel<FastqParser>(
+          bytes, shorten_names, &FastqParser::Resync);
+    }
+    return Parser<T>::Parse(bytes, shorten_names);
+  }
+
+ private:
+  std::uint64_t ParseRecords(
+      std::uint64_t bytes, bool shorten_names) override {
+    std::uint64_t num_records = 0;
     std::uint64_t parsed_bytes = 0;
-    std::uint32_t data_ptr = 0;
-    std::uint32_t comment_ptr = 0;
-    std::uint32_t quality_ptr = 0;
+    std::uint64_t data_ptr = 0;
+    std::uint64_t comment_ptr = 0;
+    std::uint64_t quality_ptr = 0;
 
     auto create_T = [&] () -> void {
       if (data_ptr == 0 || comment_ptr == 0 || quality_ptr == 0) {
@@ -38,24 +52,28 @@ class FastqParser: public Parser<T> {
             "[bioparser::FastqParser] error: invalid file format");
       }
 
+      auto name = this->Span(0, data_ptr);
       auto name_len = shorten_names ?
-          this->Shorten(this->storage().data(), data_ptr) :
-          this->RightStrip(this->storage().data(), data_ptr);
+          this->Shorten(name, data_ptr) :
+          this->RightStrip(name, data_ptr);
 
+      auto data = this->Span(data_ptr, comment_ptr);
       auto data_len = comment_ptr - data_ptr;
 
+      auto quality = this->Span(quality_ptr, this->storage_ptr());
       auto quality_len = this->storage_ptr() - quality_ptr;
 
-      if (name_len == 0 || this->storage()[0] != '@' || data_len == 0 ||
+      if (name_len == 0 || name[0] != '@' || data_len == 0 ||
           quality_len == 0 || data_len != quality_len) {
         throw std::invalid_argument(
             "[bioparser::FastqParser] error: invalid file format");
       }
 
-      dst.emplace_back(std::unique_ptr<T>(new T(
-          static_cast<const char*>(this->storage().data() + 1), name_len - 1,
-          static_cast<const char*>(this->storage().data() + data_ptr), data_len,
-          static_cast<const char*>(this->storage().data() + quality_ptr), quality_len)));  // NOLINT
+      this->Emit(
+          name + 1, name_len - 1,
+          data, data_len,
+          quality, quality_len);
+      ++num_records;
 
       parsed_bytes += this->storage_ptr();
       data_ptr = 0;
@@ -73,6 +91,10 @@ class FastqParser: public Parser<T> {
     while (true) {
       auto buffer_ptr = this->buffer_ptr();
       for (; buffer_ptr < this->buffer_bytes(); ++buffer_ptr) {
+        buffer_ptr = this->Find(buffer_ptr, '\n', is_data ? '+' : '\n');
+        if (buffer_ptr == this->buffer_bytes()) {
+          break;
+        }
         auto c = this->buffer()[buffer_ptr];
         if (c == '\n') {
           this->Store(buffer_ptr - this->buffer_ptr(), !is_name);
@@ -90,7 +112,7 @@ class FastqParser: public Parser<T> {
             is_name = true;
             create_T();
             if (parsed_bytes >= bytes) {
-              return dst;
+              return num_records;
             }
           }
         } else if (is_data && c == '+') {
@@ -113,12 +135,67 @@ class FastqParser: public Parser<T> {
       create_T();
     }
 
-    return dst;
+    return num_records;
   }
 
- private:
-  explicit FastqParser(gzFile file)
-      : Parser<T>(file, 4194304) {}  // 4 MB
+  explicit FastqParser(Reader* reader)
+      : Parser<T>(reader, 4194304) {}  // 4 MB
+
+  // returns the first line at or after pos which starts a valid record, as
+  // quality lines can start with '@' as well
+  static std::uint64_t Resync(
+      const char* data, std::uint64_t size,
+      std::uint64_t pos) {
+    auto i = pos;
+    if (i > 0) {
+      i = NextLine(data, size, i - 1);
+    }
+    for (; i < size; i = NextLine(data, size, i)) {
+      if (data[i] == '@' && IsRecord(data, size, i)) {
+        return i;
+      }
+    }
+    return size;
+  }
+
+  // returns the position following the first '\n' at or after i
+  static std::uint64_t NextLine(
+      const char* data, std::uint64_t size,
+      std::uint64_t i) {
+    auto end = Scanner::FindFirstOf(data + i, data + size, '\n', '\n');
+    return std::min<std::uint64_t>(size, end - data + 1);
+  }
+
+  // sequence lines consist of letters only and are followed by a line
+  // starting with '+', quality lines have to match them in length and are
+  // followed by another record or the end of file
+  static bool IsRecord(
+      const char* data, std::uint64_t size,
+      std::uint64_t i) {
+    std::uint64_t data_len = 0;
+    for (i = NextLine(data, size, i); i < size && data[i] != '+';) {
+      auto j = NextLine(data, size, i);
+      auto len = Parser<T>::RightStrip(data + i, j - i);
+      for (auto k = i; k < i + len; ++k) {
+        if (!std::isalpha(static_cast<unsigned char>(data[k])) &&
+            data[k] != '-' && data[k] != '*' && data[k] != '.') {
+          return false;
+        }
+      }
+      data_len += len;
+      i = j;
+    }
+    if (i == size || data_len == 0) {
+      return false;
+    }
+    std::uint64_t quality_len = 0;
+    for (i = NextLine(data, size, i); i < size && quality_len < data_len;) {
+      auto j = NextLine(data, size, i);
+      quality_len += Parser<T>::RightStrip(data + i, j - i);
+      i = j;
+    }
+    return quality_len == data_len && (i == size || data[i] == '@');
+  }
 
   friend Parser<T>;
 };
@@ -0,0 +1,173 @@
+// Copyright (c) 2026 Robert Vaser
+
+#ifndef BIOPARSER_GZIP_INDEX_HPP_
+#define BIOPARSER_GZIP_INDEX_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bioparser/inflate_reader.hpp"
+
+namespace bioparser {
+
+// access points of a gzip file (zran), which allow inflate to start close in
+// front of any offset of decompressed bytes, together with the decompressed
+// size of the file; stored as a header (magic, size and number of points)
+// followed by the points, each with its window of up to 32 kB
+class GzipIndex {
+ public:
+  GzipIndex()
+      : size_(0),
+        points_() {}
+
+  // inflates the whole file once and remembers an access point roughly every
+  // span bytes of output
+  static std::unique_ptr<GzipIndex> Build(
+      const std::string& path,
+      std::uint64_t span = 1U << 20) {  // 1 MB
+    auto file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+      throw std::invalid_argument(
+          "[bioparser::GzipIndex::Build] error: unable to open file " + path);
+    }
+    InflateReader reader(file, span, 0);
+
+    std::unique_ptr<GzipIndex> index(new GzipIndex());
+    std::vector<char> buffer(65536);  // 64 kB
+    while (true) {
+      auto bytes = reader.Read(buffer.data(), buffer.size());
+      index->size_ += bytes;
+      if (bytes < buffer.size()) {
+        break;
+      }
+    }
+    for (auto& it : reader.points()) {
+      index->Add(std::move(it));
+    }
+    return index;
+  }
+
+  // returns nullptr if the file does not exist
+  static std::unique_ptr<GzipIndex> Load(const std::string& path) {
+    std::unique_ptr<std::FILE, int(*)(std::FILE*)> file(
+        std::fopen(path.c_str(), "rb"), std::fclose);
+    if (!file) {
+      return nullptr;
+    }
+    std::unique_ptr<GzipIndex> index(new GzipIndex());
+    std::uint8_t buffer[32];
+    if (std::fread(buffer, 1, 24, file.get()) != 24 ||
+        std::memcmp(buffer, Magic(), 8) != 0) {
+      throw std::invalid_argument(
+          "[bioparser::GzipIndex::Load] error: invalid file format");
+    }
+    index->size_ = Unpack(buffer + 8);
+    auto num_points = Unpack(buffer + 16);
+    for (std::uint64_t i = 0; i < num_points; ++i) {
+      AccessPoint point;
+      std::uint64_t window_len = 0;
+      if (std::fread(buffer, 1, 32, file.get()) != 32 ||
+          Unpack(buffer + 8) > 7 ||
+          (window_len = Unpack(buffer + 24)) > 32768) {
+        throw std::invalid_argument(
+            "[bioparser::GzipIndex::Load] error: invalid file format");
+      }
+      point.compressed_offset = Unpack(buffer);
+      point.bits = Unpack(buffer + 8);
+      point.offset = Unpack(buffer + 16);
+      point.window.resize(window_len);
+      if (std::fread(point.window.data(), 1, window_len, file.get()) != window_len) {  // NOLINT
+        throw std::invalid_argument(
+            "[bioparser::GzipIndex::Load] error: invalid file format");
+      }
+      index->Add(std::move(point));
+    }
+    return index;
+  }
+
+  void Store(const std::string& path) const {
+    std::vector<std::uint8_t> dst(24);
+    std::memcpy(dst.data(), Magic(), 8);
+    Pack(size_, &dst[8]);
+    Pack(points_.size(), &dst[16]);
+    for (const auto& it : points_) {
+      auto i = dst.size();
+      dst.resize(i + 32 + it.window.size());
+      Pack(it.compressed_offset, &dst[i]);
+      Pack(it.bits, &dst[i + 8]);
+      Pack(it.offset, &dst[i + 16]);
+      Pack(it.window.size(), &dst[i + 24]);
+      std::memcpy(&dst[i + 32], it.window.data(), it.window.size());
+    }
+    std::unique_ptr<std::FILE, int(*)(std::FILE*)> file(
+        std::fopen(path.c_str(), "wb"), std::fclose);
+    if (!file || std::fwrite(dst.data(), 1, dst.size(), file.get()) != dst.size()) {  // NOLINT
+      throw std::invalid_argument(
+          "[bioparser::GzipIndex::Store] error: unable to write file " + path);
+    }
+  }
+
+  // points have to be added in file order
+  void Add(AccessPoint point) {
+    if (point.offset > size_ || (!points_.empty() &&
+        (point.compressed_offset <= points_.back().compressed_offset ||
+         point.offset < points_.back().offset))) {
+      throw std::invalid_argument(
+          "[bioparser::GzipIndex::Add] error: points out of order");
+    }
+    points_.emplace_back(std::move(point));
+  }
+
+  // returns the last access point at or before offset, or the start of file
+  const AccessPoint& Locate(std::uint64_t offset) const {
+    static const AccessPoint start;
+    auto it = std::upper_bound(
+        points_.begin(), points_.end(), offset,
+        [] (std::uint64_t lhs, const AccessPoint& rhs) -> bool {
+          return lhs < rhs.offset;
+        });
+    return it == points_.begin() ? start : *(--it);
+  }
+
+  // in decompressed bytes
+  std::uint64_t size() const {
+    return size_;
+  }
+
+  const std::vector<AccessPoint>& points() const {
+    return points_;
+  }
+
+ private:
+  static std::uint64_t Unpack(const std::uint8_t* src) {
+    std::uint64_t dst = 0;
+    for (std::uint32_t i = 0; i < 8; ++i) {
+      dst |= static_cast<std::uint64_t>(src[i]) << (8 * i);
+    }
+    return dst;
+  }
+
+  static void Pack(std::uint64_t src, std::uint8_t* dst) {
+    for (std::uint32_t i = 0; i < 8; ++i) {
+      dst[i] = static_cast<std::uint8_t>(src >> (8 * i));
+    }
+  }
+
+  static const char* Magic() {
+    return "BIOPGZX1";
+  }
+
+  std::uint64_t size_;
+  std::vector<AccessPoint> points_;
+};
+
+}  // namespace bioparser
+
+#endif  // BIOPARSER_GZIP_INDEX_HPP_
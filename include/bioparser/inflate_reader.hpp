@@ -0,0 +1,295 @@
+// Copyright (c) 2026 Robert Vaser
+
+#ifndef BIOPARSER_INFLATE_READER_HPP_
+#define BIOPARSER_INFLATE_READER_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "zlib.h"  // NOLINT
+
+#include "bioparser/reader.hpp"
+
+namespace bioparser {
+
+// deflate block boundary of a gzip file from which inflate can be restarted,
+// given the last 32 kB of output preceding it (zran)
+struct AccessPoint {
+  std::uint64_t compressed_offset = 0;  // 0 stands for the start of file
+  std::uint32_t bits = 0;  // of the byte before compressed_offset
+  std::uint64_t offset = 0;  // in decompressed bytes
+  std::vector<char> window;
+};
+
+// inflates gzip files, including concatenated members, and remembers an access
+// point roughly every span bytes of output (the most recent max_points ones,
+// 0 keeps all) so that it can be repositioned without inflating from the start
+// of file
+class InflateReader: public Reader {
+ public:
+  InflateReader(
+      std::FILE* file,
+      std::uint64_t span,
+      std::size_t max_points = 16)
+      : file_(file, std::fclose),
+        strm_(),
+        src_(65536),  // 64 kB
+        src_offset_(0),
+        offset_(0),
+        trailer_len_(0),
+        is_raw_(false),
+        is_member_start_(true),
+        is_eof_(false),
+        span_(span),
+        max_points_(max_points),
+        points_(),
+        mutex_() {
+    std::memset(&strm_, 0, sizeof(strm_));
+    if (inflateInit2(&strm_, 31) != Z_OK) {
+      throw std::bad_alloc();
+    }
+  }
+
+  InflateReader(const InflateReader&) = delete;
+  InflateReader& operator=(const InflateReader&) = delete;
+
+  InflateReader(InflateReader&&) = delete;
+  InflateReader& operator=(InflateReader&&) = delete;
+
+  ~InflateReader() {
+    inflateEnd(&strm_);
+  }
+
+  // returns nullptr if the file is not gzip compressed
+  static std::unique_ptr<Reader> Open(
+      const std::string& path,
+      std::uint64_t span = 1U << 20) {  // 1 MB
+    auto file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+      return nullptr;
+    }
+    std::uint8_t header[2];
+    if (std::fread(header, 1, 2, file) != 2 ||
+        header[0] != 31 || header[1] != 139) {
+      std::fclose(file);
+      return nullptr;
+    }
+    std::rewind(file);
+    return std::unique_ptr<Reader>(new InflateReader(file, span));
+  }
+
+  std::uint32_t Read(char* dst, std::uint32_t size) override {
+    strm_.next_out = reinterpret_cast<Bytef*>(dst);
+    strm_.avail_out = size;
+    while (strm_.avail_out > 0 && !is_eof_) {
+      if (strm_.avail_in == 0 && !Fill()) {
+        if (!is_member_start_ || trailer_len_ > 0) {
+          throw std::invalid_argument(
+              "[bioparser::InflateReader] error: invalid file format");
+        }
+        is_eof_ = true;
+        break;
+      }
+      if (trailer_len_ > 0) {  // of a member restarted as raw deflate
+        auto count = std::min(trailer_len_, strm_.avail_in);
+        strm_.next_in += count;
+        strm_.avail_in -= count;
+        trailer_len_ -= count;
+        continue;
+      }
+
+      auto avail_out = strm_.avail_out;
+      auto ret = inflate(&strm_, Z_BLOCK);
+      offset_ += avail_out - strm_.avail_out;
+      if (ret == Z_STREAM_END) {
+        if (is_raw_) {
+          trailer_len_ = 8;  // CRC32 and ISIZE
+        }
+        Restart(31);  // next member
+        continue;
+      }
+      if (ret == Z_DATA_ERROR && is_member_start_ && offset_ > 0) {
+        is_eof_ = true;  // trailing garbage is ignored as by gzread
+        break;
+      }
+      if (ret != Z_OK && (ret != Z_BUF_ERROR || strm_.avail_in > 0)) {
+        throw std::invalid_argument(
+            "[bioparser::InflateReader] error: invalid file format");
+      }
+      is_member_start_ = false;
+      if ((strm_.data_type & 128) && !(strm_.data_type & 64)) {
+        Mark();
+      }
+    }
+    return size - strm_.avail_out;
+  }
+
+  void Rewind() override {
+    Restore(AccessPoint(), 0);
+  }
+
+  void Seek(std::uint64_t offset) override {
+    Restore(Locate(offset), offset);
+  }
+
+  // returns the most recent access point at or before offset which is still
+  // remembered, or the start of file
+  AccessPoint Locate(std::uint64_t offset) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = points_.rbegin(); it != points_.rend(); ++it) {
+      if (it->offset <= offset) {
+        return *it;
+      }
+    }
+    return AccessPoint();
+  }
+
+  // returns a copy of the remembered access points in file order
+  std::vector<AccessPoint> points() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::vector<AccessPoint>(points_.begin(), points_.end());
+  }
+
+  // restarts inflate at point and skips to offset, which is not before it;
+  // point is remembered as well
+  void Restore(const AccessPoint& point, std::uint64_t offset) {
+    if (offset < point.offset) {
+      throw std::invalid_argument(
+          "[bioparser::InflateReader::Restore] error: invalid access point");
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      while (!points_.empty() && points_.back().offset >= point.offset) {
+        points_.pop_back();
+      }
+      if (span_ > 0 && point.compressed_offset > 0) {
+        Remember(point);
+      }
+    }
+
+    auto compressed_offset = point.compressed_offset - (point.bits ? 1 : 0);
+    if (std::fseek(file_.get(), point.compressed_offset == 0 ? 0 : compressed_offset, SEEK_SET) != 0) {  // NOLINT
+      throw std::invalid_argument(
+          "[bioparser::InflateReader] error: unable to seek");
+    }
+    src_offset_ = point.compressed_offset == 0 ? 0 : compressed_offset;
+    strm_.avail_in = 0;
+    trailer_len_ = 0;
+    is_eof_ = false;
+    offset_ = point.offset;
+
+    if (point.compressed_offset == 0) {
+      Restart(31);
+    } else {
+      Restart(-15);  // raw deflate up to the end of the member
+      is_member_start_ = false;
+      if (point.bits > 0) {
+        if (!Fill()) {
+          throw std::invalid_argument(
+              "[bioparser::InflateReader] error: invalid access point");
+        }
+        auto c = *strm_.next_in;
+        ++strm_.next_in;
+        --strm_.avail_in;
+        inflatePrime(&strm_, point.bits, c >> (8 - point.bits));
+      }
+      if (inflateSetDictionary(
+              &strm_,
+              reinterpret_cast<const Bytef*>(point.window.data()),
+              point.window.size()) != Z_OK) {
+        throw std::invalid_argument(
+            "[bioparser::InflateReader] error: invalid access point");
+      }
+    }
+
+    std::vector<char> buffer(65536);
+    for (auto skip = offset - point.offset; skip > 0;) {
+      auto count = std::min<std::uint64_t>(skip, buffer.size());
+      auto bytes = Read(buffer.data(), count);
+      skip -= bytes;
+      if (bytes < count) {
+        break;
+      }
+    }
+  }
+
+ private:
+  bool Fill() {
+    auto bytes = std::fread(src_.data(), 1, src_.size(), file_.get());
+    src_offset_ += bytes;
+    strm_.next_in = reinterpret_cast<Bytef*>(src_.data());
+    strm_.avail_in = bytes;
+    return bytes > 0;
+  }
+
+  // reinitializes inflate for the next gzip member (31) or raw deflate (-15),
+  // keeping the pending input
+  void Restart(int window_bits) {
+    auto next_in = strm_.next_in;
+    auto avail_in = strm_.avail_in;
+    if (inflateReset2(&strm_, window_bits) != Z_OK) {
+      throw std::invalid_argument(
+          "[bioparser::InflateReader] error: invalid file format");
+    }
+    strm_.next_in = next_in;
+    strm_.avail_in = avail_in;
+    is_raw_ = window_bits < 0;
+    is_member_start_ = true;
+  }
+
+  // remembers the current deflate block boundary if it is at least span bytes
+  // past the previous access point
+  void Mark() {
+    if (span_ == 0 || offset_ == 0) {  // start of file is implicit
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!points_.empty() && offset_ - points_.back().offset < span_) {
+      return;
+    }
+    AccessPoint point;
+    point.compressed_offset = src_offset_ - strm_.avail_in;
+    point.bits = strm_.data_type & 7;
+    point.offset = offset_;
+    point.window.resize(32768);
+    uInt window_len = 0;
+    inflateGetDictionary(
+        &strm_, reinterpret_cast<Bytef*>(point.window.data()), &window_len);
+    point.window.resize(window_len);
+    Remember(std::move(point));
+  }
+
+  void Remember(AccessPoint point) {
+    points_.emplace_back(std::move(point));
+    if (max_points_ > 0 && points_.size() > max_points_) {
+      points_.pop_front();
+    }
+  }
+
+  std::unique_ptr<std::FILE, int(*)(std::FILE*)> file_;
+  z_stream strm_;
+  std::vector<char> src_;
+  std::uint64_t src_offset_;  // of the end of src_ in the file
+  std::uint64_t offset_;  // of the next byte of output
+  std::uint32_t trailer_len_;
+  bool is_raw_;
+  bool is_member_start_;  // no input of the current member inflated yet
+  bool is_eof_;
+  std::uint64_t span_;
+  std::size_t max_points_;
+  std::deque<AccessPoint> points_;
+  mutable std::mutex mutex_;  // points_ are located from the parsing thread
+};
+
+}  // namespace bioparser
+
+#endif  // BIOPARSER_INFLATE_READER_HPP_
@@ -4,11 +4,11 @@
 #define BIOPARSER_MHAP_PARSER_HPP_
 
 #include <cstdint>
-#include <cstdlib>
 #include <memory>
 #include <vector>
 #include <stdexcept>
 
+#include "bioparser/numeric.hpp"
 #include "bioparser/parser.hpp"
 
 namespace bioparser {
@@ -24,9 +24,10 @@ class MhapParser: public Parser<T> {
 
   ~MhapParser() {}
 
-  std::vector<std::unique_ptr<T>> Parse(
-      std::uint64_t bytes, bool = true) override {
-    std::vector<std::unique_ptr<T>> dst;
+ private:
+  std::uint64_t ParseRecords(
+      std::uint64_t bytes, bool) override {
+    std::uint64_t num_records = 0;
     std::uint64_t parsed_bytes = 0;
 
     std::uint64_t lhs_id = 0;
@@ -34,42 +35,40 @@ class MhapParser: public Parser<T> {
     double error = 0;
     std::uint32_t num_minmers = 0;
     std::uint32_t lhs_strand = 0;
-    std::uint32_t lhs_begin = 0;
-    std::uint32_t lhs_end = 0;
-    std::uint32_t lhs_len = 0;
+    std::uint64_t lhs_begin = 0;
+    std::uint64_t lhs_end = 0;
+    std::uint64_t lhs_len = 0;
     std::uint32_t rhs_strand = 0;
-    std::uint32_t rhs_begin = 0;
-    std::uint32_t rhs_end = 0;
-    std::uint32_t rhs_len = 0;
+    std::uint64_t rhs_begin = 0;
+    std::uint64_t rhs_end = 0;
+    std::uint64_t rhs_len = 0;
 
     auto create_T = [&] () -> void {
-      auto storage_ptr = this->RightStrip(
-          this->storage().data(),
-          this->storage_ptr());
-      this->Terminate(storage_ptr);
+      auto line = this->Span(0, this->storage_ptr());
+      auto storage_ptr = this->RightStrip(line, this->storage_ptr());
 
+      bool is_valid = true;
       std::uint32_t num_values = 0;
-      std::uint32_t begin_ptr = 0;
+      std::uint64_t begin_ptr = 0;
       while (true) {
-        auto end_ptr = begin_ptr;
-        while (end_ptr < storage_ptr && this->storage()[end_ptr] != ' ') {
-          ++end_ptr;
-        }
-        this->Terminate(end_ptr);
+        auto end_ptr = static_cast<std::uint64_t>(Scanner::FindFirstOf(
+            line + begin_ptr, line + storage_ptr, ' ', ' ') - line);
+        auto first = line + begin_ptr;
+        auto last = line + end_ptr;
 
         switch (num_values) {
-          case 0: lhs_id = std::atoll(this->storage().data() + begin_ptr); break;  // NOLINT
-          case 1: rhs_id = std::atoll(this->storage().data() + begin_ptr); break;  // NOLINT
-          case 2: error = std::atof(this->storage().data() + begin_ptr); break;
-          case 3: num_minmers = std::atoi(this->storage().data() + begin_ptr); break;  // NOLINT
-          case 4: lhs_strand = std::atoi(this->storage().data() + begin_ptr); break;  // NOLINT
-          case 5: lhs_begin = std::atoi(this->storage().data() + begin_ptr); break;  // NOLINT
-          case 6: lhs_end = std::atoi(this->storage().data() + begin_ptr); break;  // NOLINT
-          case 7: lhs_len = std::atoi(this->storage().data() + begin_ptr); break;  // NOLINT
-          case 8: rhs_strand = std::atoi(this->storage().data() + begin_ptr); break;  // NOLINT
-          case 9: rhs_begin = std::atoi(this->storage().data() + begin_ptr); break;  // NOLINT
-          case 10: rhs_end = std::atoi(this->storage().data() + begin_ptr); break;  // NOLINT
-          case 11: rhs_len = std::atoi(this->storage().data() + begin_ptr); break;  // NOLINT
+          case 0: is_valid &= Numeric::Parse(first, last, &lhs_id); break;
+          case 1: is_valid &= Numeric::Parse(first, last, &rhs_id); break;
+          case 2: is_valid &= Numeric::Parse(first, last, &error); break;
+          case 3: is_valid &= Numeric::Parse(first, last, &num_minmers); break;
+          case 4: is_valid &= Numeric::Parse(first, last, &lhs_strand); break;
+          case 5: is_valid &= Numeric::Parse(first, last, &lhs_begin); break;
+          case 6: is_valid &= Numeric::Parse(first, last, &lhs_end); break;
+          case 7: is_valid &= Numeric::Parse(first, last, &lhs_len); break;
+          case 8: is_valid &= Numeric::Parse(first, last, &rhs_strand); break;
+          case 9: is_valid &= Numeric::Parse(first, last, &rhs_begin); break;
+          case 10: is_valid &= Numeric::Parse(first, last, &rhs_end); break;
+          case 11: is_valid &= Numeric::Parse(first, last, &rhs_len); break;
           default: break;
         }
 
@@ -80,17 +79,18 @@ class MhapParser: public Parser<T> {
         begin_ptr = end_ptr + 1;
       }
 
-      if (num_values != 12) {
+      if (!is_valid || num_values != 12) {
         throw std::invalid_argument(
             "[bioparser::MhapParser] error: invalid file format");
       }
 
-      dst.emplace_back(std::unique_ptr<T>(new T(
+      this->Emit(
           lhs_id, rhs_id,
           error,
           num_minmers,
           lhs_strand, lhs_begin, lhs_end, lhs_len,
-          rhs_strand, rhs_begin, rhs_end, rhs_len)));
+          rhs_strand, rhs_begin, rhs_end, rhs_len);
+      ++num_records;
 
       parsed_bytes += this->storage_ptr();
       this->Clear();
@@ -101,13 +101,14 @@ class MhapParser: public Parser<T> {
     while (true) {
       auto buffer_ptr = this->buffer_ptr();
       for (; buffer_ptr < this->buffer_bytes(); ++buffer_ptr) {
-        auto c = this->buffer()[buffer_ptr];
-        if (c == '\n') {
-          this->Store(buffer_ptr - this->buffer_ptr());
-          create_T();
-          if (parsed_bytes >= bytes) {
-            return dst;
-          }
+        buffer_ptr = this->Find(buffer_ptr, '\n', '\n');
+        if (buffer_ptr == this->buffer_bytes()) {
+          break;
+        }
+        this->Store(buffer_ptr - this->buffer_ptr());
+        create_T();
+        if (parsed_bytes >= bytes) {
+          return num_records;
         }
       }
       if (this->buffer_ptr() < buffer_ptr) {
@@ -124,12 +125,11 @@ class MhapParser: public Parser<T> {
       create_T();
     }
 
-    return dst;
+    return num_records;
   }
 
- private:
-  explicit MhapParser(gzFile file)
-      : Parser<T>(file, 65536) {}  // 64 kB
+  explicit MhapParser(Reader* reader)
+      : Parser<T>(reader, 65536) {}  // 64 kB
 
   friend Parser<T>;
 };
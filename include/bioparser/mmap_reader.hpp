@@ -0,0 +1,128 @@
+// Copyright (c) 2026 Robert Vaser
+
+#ifndef BIOPARSER_MMAP_READER_HPP_
+#define BIOPARSER_MMAP_READER_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define BIOPARSER_HAS_MMAP 1
+#endif
+
+#include "bioparser/reader.hpp"
+
+namespace bioparser {
+
+// maps an uncompressed file into memory so that parsers can point straight
+// into the page cache instead of copying chunks out of it
+class MmapReader: public Reader {
+ public:
+  MmapReader(const char* data, std::uint64_t size)
+      : data_(data),
+        size_(size),
+        ptr_(0),
+        is_owner_(true) {}
+
+  MmapReader(const MmapReader&) = delete;
+  MmapReader& operator=(const MmapReader&) = delete;
+
+  MmapReader(MmapReader&&) = delete;
+  MmapReader& operator=(MmapReader&&) = delete;
+
+  ~MmapReader() {
+#if defined(BIOPARSER_HAS_MMAP)
+    if (is_owner_) {
+      munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+  }
+
+  // returns nullptr for compressed, empty or non-regular files, and on
+  // platforms without mmap
+  static std::unique_ptr<Reader> Open(const std::string& path) {
+#if defined(BIOPARSER_HAS_MMAP)
+    auto fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+      return nullptr;
+    }
+    struct stat st;
+    void* data = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+      data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (data == MAP_FAILED) {
+      return nullptr;
+    }
+    if (Detect(data, st.st_size) != Compression::kNone) {
+      munmap(data, st.st_size);
+      return nullptr;
+    }
+    madvise(data, st.st_size, MADV_SEQUENTIAL);
+    return std::unique_ptr<Reader>(
+        new MmapReader(static_cast<const char*>(data), st.st_size));
+#else
+    (void) path;
+    return nullptr;
+#endif
+  }
+
+  const char* data() const {
+    return data_;
+  }
+
+  std::uint64_t size() const {
+    return size_;
+  }
+
+  // returns a reader over bytes [begin, end) which does not own them and
+  // has to be destroyed before this reader
+  std::unique_ptr<Reader> Slice(std::uint64_t begin, std::uint64_t end) const {
+    std::unique_ptr<MmapReader> slice(
+        new MmapReader(data_ + begin, end - begin));
+    slice->is_owner_ = false;
+    return std::unique_ptr<Reader>(slice.release());
+  }
+
+  // points data to the next size bytes of the mapping without copying them,
+  // the mapping stays valid for the lifetime of the reader
+  std::uint64_t Map(const char** data, std::uint64_t size) {
+    auto bytes = std::min(size, size_ - ptr_);
+    *data = data_ + ptr_;
+    ptr_ += bytes;
+    return bytes;
+  }
+
+  std::uint32_t Read(char* dst, std::uint32_t size) override {
+    const char* src = nullptr;
+    auto bytes = Map(&src, size);
+    std::memcpy(dst, src, bytes);
+    return bytes;
+  }
+
+  void Rewind() override {
+    ptr_ = 0;
+  }
+
+  void Seek(std::uint64_t offset) override {
+    ptr_ = std::min(offset, size_);
+  }
+
+ private:
+  const char* data_;
+  std::uint64_t size_;
+  std::uint64_t ptr_;
+  bool is_owner_;
+};
+
+}  // namespace bioparser
+
+#endif  // BIOPARSER_MMAP_READER_HPP_
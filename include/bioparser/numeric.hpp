@@ -0,0 +1,124 @@
+// Copyright (c) 2026 Robert Vaser
+
+#ifndef BIOPARSER_NUMERIC_HPP_
+#define BIOPARSER_NUMERIC_HPP_
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace bioparser {
+
+// converts decimal numbers spanning [first, last) without relying on a
+// terminating character; returns false on empty spans, on any character
+// that is not part of the number, and on values that do not fit into dst
+class Numeric {
+ public:
+  template<class U>
+  static typename std::enable_if<std::is_unsigned<U>::value, bool>::type Parse(  // NOLINT
+      const char* first, const char* last,
+      U* dst) {
+    std::uint64_t value = 0;
+    if (!ParseDigits(first, last, std::numeric_limits<U>::max(), &value)) {
+      return false;
+    }
+    *dst = static_cast<U>(value);
+    return true;
+  }
+
+  template<class I>
+  static typename std::enable_if<std::is_signed<I>::value && std::is_integral<I>::value, bool>::type Parse(  // NOLINT
+      const char* first, const char* last,
+      I* dst) {
+    bool is_negative = first < last && *first == '-';
+    if (first < last && (*first == '-' || *first == '+')) {
+      ++first;
+    }
+    std::uint64_t max = std::numeric_limits<I>::max();
+    std::uint64_t value = 0;
+    if (!ParseDigits(first, last, max + is_negative, &value)) {
+      return false;
+    }
+    *dst = is_negative ?
+        static_cast<I>(-static_cast<std::int64_t>(value - 1) - 1) :
+        static_cast<I>(value);
+    return true;
+  }
+
+  // falls back to std::strtod on a bounded, terminated copy
+  static bool Parse(const char* first, const char* last, double* dst) {
+    char str[64];
+    auto len = last - first;
+    if (len <= 0 || len >= static_cast<std::ptrdiff_t>(sizeof(str)) ||
+        std::strchr("+-.0123456789", *first) == nullptr) {
+      return false;
+    }
+    std::memcpy(str, first, len);
+    str[len] = '\0';
+    char* end = nullptr;
+    *dst = std::strtod(str, &end);
+    return end == str + len;
+  }
+
+ private:
+  static bool ParseDigits(
+      const char* first, const char* last,
+      std::uint64_t max,
+      std::uint64_t* dst) {
+    if (first == last) {
+      return false;
+    }
+    while (last - first > 1 && *first == '0') {
+      ++first;
+    }
+    if (last - first > std::numeric_limits<std::uint64_t>::digits10 + 1) {
+      return false;
+    }
+    std::uint64_t value = 0;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    // at most 16 digits, which can not overflow
+    for (int i = 0; i < 2 && last - first >= 8; ++i, first += 8) {
+      std::uint64_t chunk;
+      std::memcpy(&chunk, first, 8);
+      if (!IsEightDigits(chunk)) {
+        return false;
+      }
+      value = value * 100000000 + ParseEightDigits(chunk);
+    }
+#endif
+    for (; first < last; ++first) {
+      std::uint64_t digit = static_cast<unsigned char>(*first) - '0';
+      if (digit > 9 ||
+          value > (std::numeric_limits<std::uint64_t>::max() - digit) / 10) {
+        return false;
+      }
+      value = value * 10 + digit;
+    }
+    if (value > max) {
+      return false;
+    }
+    *dst = value;
+    return true;
+  }
+
+  // SWAR check and conversion of eight ASCII digits in little-endian order
+  static bool IsEightDigits(std::uint64_t chunk) {
+    return ((chunk & 0xF0F0F0F0F0F0F0F0) |
+        (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+        0x3333333333333333;
+  }
+
+  static std::uint32_t ParseEightDigits(std::uint64_t chunk) {
+    chunk -= 0x3030303030303030;
+    chunk = (chunk * 10) + (chunk >> 8);  // pairs
+    chunk = (((chunk & 0x000000FF000000FF) * 0x000F424000000064) +
+        (((chunk >> 16) & 0x000000FF000000FF) * 0x0000271000000001)) >> 32;
+    return static_cast<std::uint32_t>(chunk);
+  }
+};
+
+}  // namespace bioparser
+
+#endif  // BIOPARSER_NUMERIC_HPP_
@@ -3,13 +3,15 @@
 #ifndef BIOPARSER_PAF_PARSER_HPP_
 #define BIOPARSER_PAF_PARSER_HPP_
 
+#include <algorithm>
 #include <cstdint>
-#include <cstdlib>
 #include <memory>
 #include <vector>
 #include <stdexcept>
 
+#include "bioparser/numeric.hpp"
 #include "bioparser/parser.hpp"
+#include "bioparser/tags.hpp"
 
 namespace bioparser {
 
@@ -24,71 +26,72 @@ class PafParser: public Parser<T> {
 
   ~PafParser() {}
 
-  std::vector<std::unique_ptr<T>> Parse(
-      std::uint64_t bytes, bool shorten_names = true) override {
-    std::vector<std::unique_ptr<T>> dst;
+ private:
+  std::uint64_t ParseRecords(
+      std::uint64_t bytes, bool shorten_names) override {
+    std::uint64_t num_records = 0;
     std::uint64_t parsed_bytes = 0;
 
     const char* q_name = nullptr;
-    std::uint32_t q_name_len = 0;
-    std::uint32_t q_len = 0;
-    std::uint32_t q_begin = 0;
-    std::uint32_t q_end = 0;
+    std::uint64_t q_name_len = 0;
+    std::uint64_t q_len = 0;
+    std::uint64_t q_begin = 0;
+    std::uint64_t q_end = 0;
     const char* t_name = nullptr;
-    std::uint32_t t_name_len = 0;
-    std::uint32_t t_len = 0;
-    std::uint32_t t_begin = 0;
-    std::uint32_t t_end = 0;
-    std::uint32_t num_matches = 0;
-    std::uint32_t overlap_len = 0;
+    std::uint64_t t_name_len = 0;
+    std::uint64_t t_len = 0;
+    std::uint64_t t_begin = 0;
+    std::uint64_t t_end = 0;
+    std::uint64_t num_matches = 0;
+    std::uint64_t overlap_len = 0;
     std::uint32_t quality = 0;
     char orientation = '\0';
 
     auto create_T = [&] () -> void {
-      auto storage_ptr = this->RightStrip(
-          this->storage().data(),
-          this->storage_ptr());
-      this->Terminate(storage_ptr);
+      auto line = this->Span(0, this->storage_ptr());
+      auto storage_ptr = this->RightStrip(line, this->storage_ptr());
 
+      bool is_valid = true;
       std::uint32_t num_values = 0;
-      std::uint32_t begin_ptr = 0;
+      std::uint64_t begin_ptr = 0;
+      std::uint64_t tags_ptr = 0;
       while (true) {
-        auto end_ptr = begin_ptr;
-        while (end_ptr < storage_ptr && this->storage()[end_ptr] != '\t') {
-          ++end_ptr;
-        }
-        this->Terminate(end_ptr);
+        auto end_ptr = static_cast<std::uint64_t>(Scanner::FindFirstOf(
+            line + begin_ptr, line + storage_ptr, '\t', '\t') - line);
+        auto first = line + begin_ptr;
+        auto last = line + end_ptr;
 
         switch (num_values) {
           case 0:
-            q_name = this->storage().data() + begin_ptr;
+            q_name = line + begin_ptr;
             q_name_len = end_ptr - begin_ptr;
             break;
-          case 1: q_len = std::atoi(this->storage().data() + begin_ptr); break;
-          case 2: q_begin = std::atoi(this->storage().data() + begin_ptr); break;  // NOLINT
-          case 3: q_end = std::atoi(this->storage().data() + begin_ptr); break;
-          case 4: orientation = this->storage()[begin_ptr]; break;
+          case 1: is_valid &= Numeric::Parse(first, last, &q_len); break;
+          case 2: is_valid &= Numeric::Parse(first, last, &q_begin); break;
+          case 3: is_valid &= Numeric::Parse(first, last, &q_end); break;
+          case 4: orientation = line[begin_ptr]; break;
           case 5:
-            t_name = this->storage().data() + begin_ptr;
+            t_name = line + begin_ptr;
             t_name_len = end_ptr - begin_ptr;
             break;
-          case 6: t_len = std::atoi(this->storage().data() + begin_ptr); break;
-          case 7: t_begin = std::atoi(this->storage().data() + begin_ptr); break;  // NOLINT
-          case 8: t_end = std::atoi(this->storage().data() + begin_ptr); break;
-          case 9: num_matches = std::atoi(this->storage().data() + begin_ptr); break;  // NOLINT
-          case 10: overlap_len = std::atoi(this->storage().data() + begin_ptr); break;  // NOLINT
-          case 11: quality = std::atoi(this->storage().data() + begin_ptr); break;  // NOLINT
+          case 6: is_valid &= Numeric::Parse(first, last, &t_len); break;
+          case 7: is_valid &= Numeric::Parse(first, last, &t_begin); break;
+          case 8: is_valid &= Numeric::Parse(first, last, &t_end); break;
+          case 9: is_valid &= Numeric::Parse(first, last, &num_matches); break;
+          case 10: is_valid &= Numeric::Parse(first, last, &overlap_len); break;
+          case 11: is_valid &= Numeric::Parse(first, last, &quality); break;
           default: break;
         }
 
         ++num_values;
         if (end_ptr == storage_ptr || num_values == 12) {
+          tags_ptr = std::min(end_ptr + 1, storage_ptr);  // optional fields
           break;
         }
         begin_ptr = end_ptr + 1;
       }
 
-      if (num_values != 12) {
+      if (!is_valid || num_values != 12) {
         throw std::invalid_argument(
             "[bioparser::PafParser] error: invalid file format");
       }
@@ -106,13 +109,15 @@ class PafParser: public Parser<T> {
             "[bioparser::PafParser] error: invalid file format");
       }
 
-      dst.emplace_back(std::unique_ptr<T>(new T(
+      this->EmitTagged(
+          line + tags_ptr, storage_ptr - tags_ptr,
           q_name, q_name_len, q_len, q_begin, q_end,
           orientation,
           t_name, t_name_len, t_len, t_begin, t_end,
           num_matches,
           overlap_len,
-          quality)));
+          quality);
+      ++num_records;
 
       parsed_bytes += this->storage_ptr();
       this->Clear();
@@ -123,13 +128,14 @@ class PafParser: public Parser<T> {
     while (true) {
       auto buffer_ptr = this->buffer_ptr();
       for (; buffer_ptr < this->buffer_bytes(); ++buffer_ptr) {
-        auto c = this->buffer()[buffer_ptr];
-        if (c == '\n') {
-          this->Store(buffer_ptr - this->buffer_ptr());
-          create_T();
-          if (parsed_bytes >= bytes) {
-            return dst;
-          }
+        buffer_ptr = this->Find(buffer_ptr, '\n', '\n');
+        if (buffer_ptr == this->buffer_bytes()) {
+          break;
+        }
+        this->Store(buffer_ptr - this->buffer_ptr());
+        create_T();
+        if (parsed_bytes >= bytes) {
+          return num_records;
         }
       }
       if (this->buffer_ptr() < buffer_ptr) {
@@ -146,12 +152,11 @@ class PafParser: public Parser<T> {
       create_T();
     }
 
-    return dst;
+    return num_records;
   }
 
- private:
-  explicit PafParser(gzFile file)
-      : Parser<T>(file, 65536) {}  // 64 kB
+  explicit PafParser(Reader* reader)
+      : Parser<T>(reader, 65536) {}  // 64 kB
 
   friend Parser<T>;
 };
@@ -4,19 +4,63 @@
 #define BIOPARSER_PARSER_HPP_
 
 #include <algorithm>
+#include <array>
 #include <cctype>
 #include <cstdint>
 #include <cstring>
+#include <functional>
+#include <future>
+#include <iterator>
 #include <limits>
 #include <memory>
+#include <new>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "zlib.h"  // NOLINT
 
+#include "bioparser/batch.hpp"
+#include "bioparser/bgzf_reader.hpp"
+#include "bioparser/buffer_tuner.hpp"
+#include "bioparser/checkpoint.hpp"
+#include "bioparser/gzip_index.hpp"
+#include "bioparser/inflate_reader.hpp"
+#include "bioparser/mmap_reader.hpp"
+#include "bioparser/read_ahead.hpp"
+#include "bioparser/reader.hpp"
+#include "bioparser/scanner.hpp"
+#include "bioparser/xz_reader.hpp"
+#include "bioparser/zstd_reader.hpp"
+
 namespace bioparser {
 
+struct Options {
+  // number of chunks (reads of buffer_size) decompressed ahead on a background
+  // thread, 0 decompresses synchronously on the calling thread
+  std::uint32_t read_ahead = 0;
+  // number of threads inflating BGZF blocks in parallel, other gzip files
+  // are always inflated on a single thread; memory mapped FASTA and FASTQ
+  // files are instead split into ranges which are parsed in parallel
+  std::uint32_t num_threads = 1;
+  // uncompressed files are memory mapped and records that do not span
+  // multiple reads are handed over without being copied
+  bool map_uncompressed = true;
+  // bytes requested from the reader at once, 0 picks 64 kB; larger reads
+  // save system calls on network filesystems and fast disks
+  std::uint32_t buffer_size = 0;
+  // initial capacity for records spanning multiple reads, which grows as
+  // needed; 0 picks the format default (4 MB for FASTA/FASTQ, 64 kB otherwise)
+  std::uint64_t storage_size = 0;
+  // adjusts the read size between buffer_size and max_buffer_size, and the
+  // storage capacity, to observed record sizes and throughput (BufferTuner);
+  // storage then starts at 64 kB unless storage_size is set
+  bool adaptive_buffers = false;
+  std::uint32_t max_buffer_size = 1U << 24;  // 16 MB
+};
+
 template<class T>
 class Parser {  // Parser factory
  public:
@@ -29,94 +73,442 @@ class Parser {  // Parser factory
   virtual ~Parser() {}
 
   template<template<class> class P>
-  static std::unique_ptr<Parser<T>> Create(const std::string& path) {
-    auto file = gzopen(path.c_str(), "r");
-    if (file == nullptr) {
-      throw std::invalid_argument(
-          "[bioparser::Parser::Create] error: unable to open file " + path);
+  static std::unique_ptr<Parser<T>> Create(
+      const std::string& path,
+      const Options& options = Options()) {
+    std::unique_ptr<Reader> reader;
+    if (options.map_uncompressed) {
+      reader = MmapReader::Open(path);
+    }
+    if (!reader && options.num_threads > 1) {
+      reader = BgzfReader::Open(path, options.num_threads);
+    }
+    if (!reader) {
+      reader = InflateReader::Open(path);
+    }
+    if (!reader) {
+      reader = XzReader::Open(path);
+    }
+    if (!reader) {
+      reader = ZstdReader::Open(path);
     }
-    return std::unique_ptr<Parser<T>>(new P<T>(file));
+    if (!reader) {
+      auto file = gzopen(path.c_str(), "r");
+      if (file == nullptr) {
+        throw std::invalid_argument(
+            "[bioparser::Parser::Create] error: unable to open file " + path);
+      }
+      reader.reset(new GzReader(file));
+    }
+    return Assemble<P>(reader.release(), path, options);
+  }
+
+  // parses the records of a gzip compressed file which start in [begin, end)
+  // of decompressed bytes, inflating from the access point in front of begin;
+  // both bounds are moved to the next record boundary so that consecutive
+  // ranges (e.g. of different workers) cover each record exactly once, and
+  // checkpoints of the parser are relative to the moved begin
+  template<template<class> class P>
+  static std::unique_ptr<Parser<T>> Create(
+      const std::string& path,
+      const GzipIndex& index,
+      std::uint64_t begin,
+      std::uint64_t end = -1,
+      const Options& options = Options()) {
+    auto open = [&] () -> std::unique_ptr<InflateReader> {
+      auto file = std::fopen(path.c_str(), "rb");
+      if (file == nullptr) {
+        throw std::invalid_argument(
+            "[bioparser::Parser::Create] error: unable to open file " + path);
+      }
+      return std::unique_ptr<InflateReader>(new InflateReader(file, 1U << 20));
+    };
+
+    // returns the first record boundary at or after offset
+    auto resync = [&] (std::uint64_t offset) -> std::uint64_t {
+      if (offset == 0 || offset >= index.size()) {
+        return std::min(offset, index.size());
+      }
+      auto reader = open();
+      reader->Restore(index.Locate(offset - 1), offset - 1);
+      std::vector<char> data;
+      std::uint64_t size = 0;
+      for (std::uint64_t capacity = 1U << 20; ; capacity *= 2) {  // 1 MB
+        data.resize(capacity);
+        size += reader->Read(&data[size], capacity - size);
+        auto pos = P<T>::Resync(data.data(), size, 1);
+        if (pos < size || size < capacity) {
+          return offset - 1 + pos;
+        }
+      }
+    };
+
+    begin = resync(begin);
+    end = std::max(begin, resync(end));
+
+    auto reader = open();
+    reader->Restore(index.Locate(begin), begin);
+    return Assemble<P>(
+        new RangeReader(reader.release(), begin, end),
+        path,
+        options);
   }
 
   // by default, all parsers shrink sequence names to the first white space
   virtual std::vector<std::unique_ptr<T>> Parse(
-      std::uint64_t bytes, bool shorten_names = true) = 0;
+      std::uint64_t bytes, bool shorten_names = true) {
+    std::vector<std::unique_ptr<T>> dst;
+    Start();
+    sink_.records = &dst;
+    ParseRecords(bytes, shorten_names);
+    return dst;
+  }
+
+  // passes each record to callback as a temporary instead of collecting heap
+  // allocated records, and returns the number of records; T can be a view as
+  // its pointers are valid only during the call (memory mapped input is
+  // parsed on the calling thread)
+  template<class F, class = typename std::enable_if<
+      !std::is_arithmetic<typename std::decay<F>::type>::value>::type>
+  std::uint64_t Parse(
+      std::uint64_t bytes,
+      F&& callback,
+      bool shorten_names = true) {
+    std::function<void(T&&)> function(std::forward<F>(callback));
+    Start();
+    sink_.callback = &function;
+    return ParseRecords(bytes, shorten_names);
+  }
+
+  // replaces the content of dst with records constructed in its arena, or
+  // overwritten in place if dst holds records from a previous call, and
+  // returns their number (memory mapped input is parsed on the calling thread)
+  std::uint64_t Parse(
+      std::uint64_t bytes,
+      Batch<T>* dst,
+      bool shorten_names = true) {
+    dst->Recycle();
+    Start();
+    sink_.batch = dst;
+    return ParseRecords(bytes, shorten_names);
+  }
+
+  // returns the record holding bases [begin, end) of the named sequence, read
+  // straight from the file without parsing the records in front of it;
+  // supported only by FastaParser
+  virtual std::unique_ptr<T> Fetch(
+      const std::string& name,
+      std::uint64_t begin,
+      std::uint64_t end) {
+    (void) name;
+    (void) begin;
+    (void) end;
+    throw std::invalid_argument(
+        "[bioparser::Parser::Fetch] error: random access is not supported");
+  }
 
   void Reset() {
-    gzseek(file_.get(), 0, SEEK_SET);
+    if (read_ahead_) {
+      read_ahead_->Rewind();
+    } else {
+      reader_->Rewind();
+    }
+    buffer_offset_ = 0;
+    buffer_ptr_ = 0;
+    buffer_bytes_ = 0;
+    Clear();
+  }
+
+  // returns the record boundary at which the next Parse() call starts; gzip
+  // compressed files carry the access point in front of it, which is at most
+  // about 1 MB away
+  Checkpoint Save() const {
+    Checkpoint checkpoint;
+    checkpoint.offset = offset();
+    if (auto inflate_reader = dynamic_cast<InflateReader*>(reader_.get())) {
+      checkpoint.point = inflate_reader->Locate(checkpoint.offset);
+    }
+    return checkpoint;
+  }
+
+  // continues parsing from a checkpoint of the same file, which might have
+  // been saved by another parser; compressed files without an access point
+  // (e.g. saved while inflating BGZF blocks in parallel) are inflated from
+  // the nearest BGZF block or the start of file
+  void Restore(const Checkpoint& checkpoint) {
+    auto seek = [&] (Reader* reader) -> void {
+      if (auto inflate_reader = dynamic_cast<InflateReader*>(reader)) {
+        inflate_reader->Restore(
+            checkpoint.point.offset <= checkpoint.offset ?
+                checkpoint.point :
+                AccessPoint(),
+            checkpoint.offset);
+      } else {
+        reader->Seek(checkpoint.offset);
+      }
+    };
+    if (read_ahead_) {
+      read_ahead_->Reposition(seek);
+    } else {
+      seek(reader_.get());
+    }
+    buffer_offset_ = checkpoint.offset;
     buffer_ptr_ = 0;
     buffer_bytes_ = 0;
+    Clear();
   }
 
  protected:
-  Parser(gzFile file, std::uint32_t storage_size)
-      : file_(file, gzclose),
-        buffer_(65536, 0),  // 64 kB
+  Parser(Reader* reader, std::uint32_t storage_size)
+      : path_(),
+        reader_(reader),
+        mmap_reader_(dynamic_cast<MmapReader*>(reader)),
+        buffer_(mmap_reader_ ? 0 : 65536, 0),  // 64 kB
+        buffer_data_(buffer_.data()),
+        buffer_offset_(0),
         buffer_ptr_(0),
         buffer_bytes_(0),
         storage_(storage_size, 0),
-        storage_ptr_(0) {}
+        storage_ptr_(0),
+        pieces_(),
+        num_pieces_(0),
+        num_threads_(1),
+        sink_(),
+        tuner_(),
+        read_ahead_() {}
+
+  // parses records up to at least the given number of bytes and hands them
+  // over to Emit(), returns the number of records
+  virtual std::uint64_t ParseRecords(
+      std::uint64_t bytes, bool shorten_names) = 0;
 
-  const std::vector<char>& buffer() const {
-    return buffer_;
+  // constructs a record from args for the sink of the current Parse() call
+  template<class... Args>
+  void Emit(Args&&... args) {
+    if (sink_.records) {
+      sink_.records->emplace_back(Construct(std::forward<Args>(args)...));
+    } else if (sink_.callback) {
+      (*sink_.callback)(T(std::forward<Args>(args)...));
+    } else {
+      sink_.batch->Emplace(std::forward<Args>(args)...);
+    }
+  }
+
+  // appends the optional fields of a record to args if T can be constructed
+  // from them, otherwise they are left out
+  template<class... Args>
+  void EmitTagged(const char* tags, std::uint64_t tags_len, Args&&... args) {
+    EmitTagged(
+        std::is_constructible<T, Args..., const char*, std::uint64_t>(),
+        tags, tags_len,
+        std::forward<Args>(args)...);
   }
 
-  std::uint32_t buffer_ptr() const {
+  template<class... Args>
+  static std::unique_ptr<T> Construct(Args&&... args) {
+    return std::unique_ptr<T>(new T(std::forward<Args>(args)...));
+  }
+
+  // returns the start of the first line at or after pos, which is a record
+  // boundary for line based formats (see Create() with a GzipIndex)
+  static std::uint64_t Resync(
+      const char* data, std::uint64_t size,
+      std::uint64_t pos) {
+    if (pos == 0) {
+      return 0;
+    }
+    auto end = Scanner::FindFirstOf(data + pos - 1, data + size, '\n', '\n');
+    return std::min<std::uint64_t>(size, end - data + 1);
+  }
+
+  // of the next byte of the buffer in decompressed bytes
+  std::uint64_t offset() const {
+    return buffer_offset_ + std::min(buffer_ptr_, buffer_bytes_);
+  }
+
+  // empty for parsers of memory mapped ranges
+  const std::string& path() const {
+    return path_;
+  }
+
+  const char* buffer() const {
+    return buffer_data_;
+  }
+
+  std::uint64_t buffer_ptr() const {
     return buffer_ptr_;
   }
 
-  std::uint32_t buffer_bytes() const {
+  std::uint64_t buffer_bytes() const {
     return buffer_bytes_;
   }
 
-  const std::vector<char>& storage() const {
-    return storage_;
+  std::uint64_t storage_ptr() const {
+    return storage_ptr_;
   }
 
-  std::uint32_t storage_ptr() const {
-    return storage_ptr_;
+  // greater than one only for memory mapped input
+  std::uint32_t num_threads() const {
+    return num_threads_;
+  }
+
+  // returns the position of the first c0 or c1 in the buffer at or after i,
+  // or buffer_bytes() if there is none
+  std::uint64_t Find(std::uint64_t i, char c0, char c1) const {
+    return Scanner::FindFirstOf(
+        buffer_data_ + i, buffer_data_ + buffer_bytes_, c0, c1) - buffer_data_;
+  }
+
+  // returns stored bytes [begin, end), which point straight into the buffer if
+  // they were stored in a single piece, otherwise all pieces are copied
+  const char* Span(std::uint64_t begin, std::uint64_t end) {
+    for (std::uint32_t i = 0; i < num_pieces_; ++i) {
+      const auto& it = pieces_[i];
+      if (begin >= it.begin && end <= it.begin + it.len) {
+        return it.data + (begin - it.begin);
+      }
+    }
+    Materialize();
+    return storage_.data() + begin;
   }
 
   bool Read() {
+    buffer_offset_ += buffer_bytes_;
     buffer_ptr_ = 0;
-    buffer_bytes_ = gzread(file_.get(), buffer_.data(), buffer_.size());
+    if (mmap_reader_) {  // pieces stay valid for the lifetime of the mapping
+      buffer_bytes_ = mmap_reader_->Map(&buffer_data_, kMapSize);
+      return buffer_bytes_ < kMapSize;
+    }
+    Materialize();
+    if (tuner_) {
+      Tune();
+    }
+    buffer_bytes_ = read_ahead_ ?
+        read_ahead_->Swap(&buffer_) :
+        reader_->Read(buffer_.data(), buffer_.size());
+    buffer_data_ = buffer_.data();
     return buffer_bytes_ < buffer_.size();
   }
 
-  void Store(std::size_t count, bool strip = false) {
-    if (buffer_ptr_ + count > buffer_.size()) {
+  // bytes followed by the sought character are recorded as a piece of the
+  // buffer, pieces are copied to storage only once a span covers more than
+  // one of them, or before the buffer is refilled
+  void Store(std::uint64_t count, bool strip = false) {
+    if (buffer_ptr_ + count > buffer_bytes_) {
       throw std::invalid_argument(
           "[bioparser::Parser::Store] error: buffer overflow");
     }
-    if (storage_ptr_ + count > std::numeric_limits<std::uint32_t>::max()) {
-      throw std::invalid_argument(
-          "[bioparser::Parser::Store] error: storage overflow");
-    }
-    if (storage_ptr_ + count > storage_.size()) {
-      storage_.resize(2 * storage_.size());
+    auto data = buffer_data_ + buffer_ptr_;
+    auto len = strip ? RightStrip(data, count) : count;
+    if (buffer_ptr_ + count < buffer_bytes_ &&
+        (num_pieces_ > 0 || storage_ptr_ == 0) &&
+        num_pieces_ < pieces_.size()) {
+      if (len > 0) {
+        pieces_[num_pieces_++] = {storage_ptr_, data, len};
+      }
+    } else {
+      Materialize();
+      Reserve(storage_ptr_ + len);
+      std::memcpy(&storage_[storage_ptr_], data, len);
     }
-    std::memcpy(&storage_[storage_ptr_], &buffer_[buffer_ptr_], count);
-    storage_ptr_ += strip ? RightStrip(&storage_[storage_ptr_], count) : count;
+    storage_ptr_ += len;
     buffer_ptr_ += count + 1;  // ignore sought character
   }
 
-  void Terminate(std::uint32_t i) {
-    storage_[i] = '\0';
+  // stores the next count bytes of the buffer as they are, for binary formats
+  // without a sought character
+  void Take(std::uint64_t count) {
+    if (buffer_ptr_ + count > buffer_bytes_) {
+      throw std::invalid_argument(
+          "[bioparser::Parser::Take] error: buffer overflow");
+    }
+    auto data = buffer_data_ + buffer_ptr_;
+    if ((num_pieces_ > 0 || storage_ptr_ == 0) &&
+        num_pieces_ < pieces_.size()) {
+      if (count > 0) {
+        pieces_[num_pieces_++] = {storage_ptr_, data, count};
+      }
+    } else {
+      Materialize();
+      Reserve(storage_ptr_ + count);
+      std::memcpy(&storage_[storage_ptr_], data, count);
+    }
+    storage_ptr_ += count;
+    buffer_ptr_ += count;
   }
 
   void Clear() {
+    if (tuner_) {
+      tuner_->Observe(storage_ptr_);
+    }
     storage_ptr_ = 0;
+    num_pieces_ = 0;
   }
 
-  static std::uint32_t RightStrip(const char* str, std::uint32_t str_len) {
+  // splits the next bytes of the mapping into num_threads() ranges starting
+  // at record boundaries found by resync, and parses each range with its own
+  // parser of type P; records are returned in their original order
+  template<template<class> class P>
+  std::vector<std::unique_ptr<T>> ParseInParallel(
+      std::uint64_t bytes,
+      bool shorten_names,
+      std::uint64_t (*resync)(const char*, std::uint64_t, std::uint64_t)) {
+    if (buffer_bytes_ == 0) {
+      Read();  // whole file
+    }
+    auto begin = buffer_ptr_;
+    auto end = buffer_bytes_;
+    if (bytes < end - begin) {
+      auto pos = begin + std::max<std::uint64_t>(bytes, 1);
+      end = resync(buffer_data_, buffer_bytes_, pos);
+    }
+
+    std::vector<std::uint64_t> bounds(1, begin);
+    for (std::uint32_t i = 1; i < num_threads_; ++i) {
+      auto pos = begin + (end - begin) / num_threads_ * i;
+      bounds.emplace_back(std::min(end, std::max(
+          bounds.back(),
+          resync(buffer_data_, buffer_bytes_, pos))));
+    }
+    bounds.emplace_back(end);
+
+    std::vector<std::future<std::vector<std::unique_ptr<T>>>> futures;
+    auto mmap_reader = mmap_reader_;
+    auto offset = buffer_offset_;  // slices are relative to the mapping
+    for (std::uint32_t i = 0; i < num_threads_; ++i) {
+      auto range_begin = offset + bounds[i];
+      auto range_end = offset + bounds[i + 1];
+      if (range_begin == range_end) {
+        continue;
+      }
+      futures.emplace_back(std::async(std::launch::async, [=] () {
+        std::unique_ptr<Parser<T>> parser(
+            new P<T>(mmap_reader->Slice(range_begin, range_end).release()));
+        return parser->Parse(-1, shorten_names);
+      }));
+    }
+    buffer_ptr_ = end;
+
+    std::vector<std::unique_ptr<T>> dst;
+    for (auto& it : futures) {
+      auto records = it.get();
+      dst.insert(
+          dst.end(),
+          std::make_move_iterator(records.begin()),
+          std::make_move_iterator(records.end()));
+    }
+    return dst;
+  }
+
+  static std::uint64_t RightStrip(const char* str, std::uint64_t str_len) {
     while (str_len > 0 && std::isspace(str[str_len - 1])) {
       --str_len;
     }
     return str_len;
   }
 
-  static std::uint32_t Shorten(const char* str, std::uint32_t str_len) {
-    for (std::uint32_t i = 0; i < str_len; ++i) {
+  static std::uint64_t Shorten(const char* str, std::uint64_t str_len) {
+    for (std::uint64_t i = 0; i < str_len; ++i) {
       if (std::isspace(str[i])) {
         return i;
       }
@@ -125,14 +517,144 @@ class Parser {  // Parser factory
   }
 
  private:
-  std::unique_ptr<gzFile_s, int(*)(gzFile)> file_;
+  struct Sink {  // exactly one is set
+    std::vector<std::unique_ptr<T>>* records = nullptr;
+    const std::function<void(T&&)>* callback = nullptr;
+    Batch<T>* batch = nullptr;
+  };
+
+  template<template<class> class P>
+  static std::unique_ptr<Parser<T>> Assemble(
+      Reader* reader,
+      const std::string& path,
+      const Options& options) {
+    std::unique_ptr<Parser<T>> parser(new P<T>(reader));
+    parser->path_ = path;
+    if (parser->mmap_reader_) {
+      parser->num_threads_ = std::max(options.num_threads, 1U);
+    } else {
+      if (options.buffer_size > 0) {
+        parser->buffer_.resize(options.buffer_size);
+        parser->buffer_data_ = parser->buffer_.data();
+      }
+      if (options.adaptive_buffers) {
+        parser->tuner_.reset(new BufferTuner(
+            parser->buffer_.size(),
+            std::max<std::uint32_t>(
+                options.max_buffer_size,
+                parser->buffer_.size())));
+      }
+    }
+    if (options.storage_size > 0 || options.adaptive_buffers) {
+      std::vector<char>(options.storage_size > 0 ?
+          options.storage_size :
+          std::min<std::uint64_t>(parser->storage_.size(), 1U << 16)).swap(
+              parser->storage_);
+    }
+    if (options.read_ahead > 0 && !parser->mmap_reader_) {
+      parser->read_ahead_.reset(new ReadAhead(
+          parser->reader_.get(),
+          parser->buffer_.size(),
+          options.read_ahead));
+    }
+    return parser;
+  }
+
+  template<class... Args>
+  void EmitTagged(
+      std::true_type,
+      const char* tags, std::uint64_t tags_len,
+      Args&&... args) {
+    Emit(std::forward<Args>(args)..., tags, tags_len);
+  }
+
+  template<class... Args>
+  void EmitTagged(
+      std::false_type,
+      const char*, std::uint64_t,
+      Args&&... args) {
+    Emit(std::forward<Args>(args)...);
+  }
+
+  struct Piece {
+    std::uint64_t begin;  // in storage
+    const char* data;  // in buffer
+    std::uint64_t len;
+  };
+
+  // the whole file is mapped at once
+  static constexpr std::uint64_t kMapSize =
+      std::numeric_limits<std::uint64_t>::max();
+
+  // resets the sink and the throughput measurement at the start of a Parse()
+  // call, as time spent between calls is not parsing
+  void Start() {
+    sink_ = Sink();
+    if (tuner_) {
+      tuner_->Pause();
+    }
+  }
+
+  // reports the previous read to the tuner before the next one, and resizes
+  // the buffer (or the chunks read ahead) and the storage accordingly
+  void Tune() {
+    if (buffer_bytes_ < buffer_.size()) {  // not full or the first read
+      return;
+    }
+    if (tuner_->Tick(buffer_bytes_)) {
+      if (read_ahead_) {
+        read_ahead_->Resize(tuner_->size());
+      } else {
+        buffer_.resize(tuner_->size());
+      }
+    }
+    auto storage_size = tuner_->storage_size();
+    if (storage_.size() > 4 * storage_size && storage_ptr_ <= storage_size) {
+      std::vector<char>(
+          storage_.begin(),
+          storage_.begin() + storage_size).swap(storage_);
+    }
+  }
+
+  void Reserve(std::uint64_t size) {
+    while (size > storage_.size()) {
+      storage_.resize(2 * storage_.size());
+    }
+  }
+
+  void Materialize() {
+    if (num_pieces_ == 0) {
+      return;
+    }
+    Reserve(storage_ptr_);
+    for (std::uint32_t i = 0; i < num_pieces_; ++i) {
+      const auto& it = pieces_[i];
+      std::memcpy(&storage_[it.begin], it.data, it.len);
+    }
+    num_pieces_ = 0;
+  }
+
+  std::string path_;
+  std::unique_ptr<Reader> reader_;
+  MmapReader* mmap_reader_;
   std::vector<char> buffer_;
-  std::uint32_t buffer_ptr_;
-  std::uint32_t buffer_bytes_;
+  const char* buffer_data_;
+  std::uint64_t buffer_offset_;  // of buffer_data_ in decompressed bytes
+  std::uint64_t buffer_ptr_;
+  std::uint64_t buffer_bytes_;
   std::vector<char> storage_;
-  std::uint32_t storage_ptr_;
+  std::uint64_t storage_ptr_;
+  std::array<Piece, 4> pieces_;  // at most one per line of a record
+  std::uint32_t num_pieces_;
+  std::uint32_t num_threads_;  // parsing memory mapped input
+  Sink sink_;
+  std::unique_ptr<BufferTuner> tuner_;  // adaptive buffers only
+  std::unique_ptr<ReadAhead> read_ahead_;  // destroyed before reader_
 };
 
+template<class T>
+constexpr std::uint64_t Parser<T>::kMapSize;
+
 }  // namespace bioparser
 
 #endif  // BIOPARSER_PARSER_HPP_
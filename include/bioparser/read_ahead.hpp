@@ -0,0 +1,163 @@
+// Copyright (c) 2026 Robert Vaser
+
+#ifndef BIOPARSER_READ_AHEAD_HPP_
+#define BIOPARSER_READ_AHEAD_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "bioparser/reader.hpp"
+
+namespace bioparser {
+
+// decompresses a ring of chunks on a background thread so that inflate
+// overlaps with parsing on the calling thread
+class ReadAhead {
+ public:
+  ReadAhead(Reader* reader, std::uint32_t chunk_size, std::uint32_t num_chunks)
+      : reader_(reader),
+        chunk_size_(chunk_size),
+        chunks_(num_chunks, std::vector<char>(chunk_size, 0)),
+        chunk_bytes_(num_chunks, 0),
+        head_(0),
+        num_ready_(0),
+        is_eof_(false),
+        is_stopped_(false),
+        exception_(),
+        mutex_(),
+        cv_(),
+        thread_() {
+    Start();
+  }
+
+  ReadAhead(const ReadAhead&) = delete;
+  ReadAhead& operator=(const ReadAhead&) = delete;
+
+  ReadAhead(ReadAhead&&) = delete;
+  ReadAhead& operator=(ReadAhead&&) = delete;
+
+  ~ReadAhead() {
+    Stop();
+  }
+
+  // exchanges buffer with the oldest decompressed chunk and returns the number
+  // of valid bytes, which is less than buffer->size() only at the end of file;
+  // buffer is resized to the chunk size before it is read into
+  std::uint32_t Swap(std::vector<char>* buffer) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [&] () { return num_ready_ > 0 || is_eof_; });
+    if (num_ready_ == 0) {
+      if (exception_) {
+        std::rethrow_exception(exception_);
+      }
+      return 0;
+    }
+    std::swap(*buffer, chunks_[head_]);
+    auto bytes = chunk_bytes_[head_];
+    head_ = (head_ + 1) % chunks_.size();
+    --num_ready_;
+    cv_.notify_all();
+    return bytes;
+  }
+
+  // size of chunks read from now on, chunks read ahead keep their size
+  void Resize(std::uint32_t chunk_size) {
+    chunk_size_ = chunk_size;
+  }
+
+  void Rewind() {
+    Reposition([] (Reader* reader) -> void { reader->Rewind(); });
+  }
+
+  // stops reading ahead, repositions the reader through f and starts over
+  template<class F>
+  void Reposition(F&& f) {
+    Stop();
+    f(reader_);
+    head_ = 0;
+    num_ready_ = 0;
+    is_eof_ = false;
+    is_stopped_ = false;
+    exception_ = nullptr;
+    Start();
+  }
+
+ private:
+  void Start() {
+    thread_ = std::thread(&ReadAhead::Run, this);
+  }
+
+  void Stop() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      is_stopped_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  void Run() {
+    while (true) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [&] () {
+        return is_stopped_ || num_ready_ < chunks_.size();
+      });
+      if (is_stopped_) {
+        return;
+      }
+      auto tail = (head_ + num_ready_) % chunks_.size();
+      lock.unlock();
+
+      std::uint32_t bytes = 0;
+      std::exception_ptr exception;
+      chunks_[tail].resize(chunk_size_);
+      try {
+        bytes = reader_->Read(chunks_[tail].data(), chunks_[tail].size());
+      } catch (...) {
+        exception = std::current_exception();
+      }
+
+      lock.lock();
+      if (exception) {  // handed over once all preceding chunks are consumed
+        exception_ = exception;
+        is_eof_ = true;
+        cv_.notify_all();
+        return;
+      }
+      chunk_bytes_[tail] = bytes;
+      ++num_ready_;
+      if (bytes < chunks_[tail].size()) {
+        is_eof_ = true;
+      }
+      cv_.notify_all();
+      if (is_eof_) {
+        return;
+      }
+    }
+  }
+
+  Reader* reader_;
+  std::atomic<std::uint32_t> chunk_size_;
+  std::vector<std::vector<char>> chunks_;
+  std::vector<std::uint32_t> chunk_bytes_;
+  std::uint32_t head_;
+  std::uint32_t num_ready_;
+  bool is_eof_;
+  bool is_stopped_;
+  std::exception_ptr exception_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::thread thread_;
+};
+
+}  // namespace bioparser
+
+#endif  // BIOPARSER_READ_AHEAD_HPP_
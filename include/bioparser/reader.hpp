@@ -0,0 +1,127 @@
+// Copyright (c) 2026 Robert Vaser
+
+#ifndef BIOPARSER_READER_HPP_
+#define BIOPARSER_READER_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+
+#include "zlib.h"  // NOLINT
+
+namespace bioparser {
+
+class Reader {  // source of decompressed bytes
+ public:
+  enum class Compression {
+    kNone,
+    kGzip,  // BGZF included
+    kXz,
+    kZstd
+  };
+
+  virtual ~Reader() {}
+
+  // guesses the compression from the magic bytes at the start of data
+  static Compression Detect(const void* data, std::uint64_t size) {
+    auto bytes = static_cast<const unsigned char*>(data);
+    if (size >= 2 && bytes[0] == 0x1F && bytes[1] == 0x8B) {
+      return Compression::kGzip;
+    }
+    if (size >= 6 && bytes[0] == 0xFD && bytes[1] == '7' && bytes[2] == 'z' &&
+        bytes[3] == 'X' && bytes[4] == 'Z' && bytes[5] == 0x00) {
+      return Compression::kXz;
+    }
+    if (size >= 4 && bytes[0] == 0x28 && bytes[1] == 0xB5 &&
+        bytes[2] == 0x2F && bytes[3] == 0xFD) {
+      return Compression::kZstd;
+    }
+    return Compression::kNone;
+  }
+
+  // reads the magic bytes of file and rewinds it
+  static Compression Detect(std::FILE* file) {
+    unsigned char bytes[6];
+    auto size = std::fread(bytes, 1, 6, file);
+    std::rewind(file);
+    return Detect(bytes, size);
+  }
+
+  // fills dst with up to size bytes and returns how many were written,
+  // which is less than size only at the end of file
+  virtual std::uint32_t Read(char* dst, std::uint32_t size) = 0;
+
+  virtual void Rewind() = 0;
+
+  // positions the reader at the given offset of decompressed bytes
+  virtual void Seek(std::uint64_t offset) = 0;
+};
+
+class GzReader: public Reader {  // zlib, handles uncompressed files as well
+ public:
+  explicit GzReader(gzFile file)
+      : file_(file, gzclose) {}
+
+  std::uint32_t Read(char* dst, std::uint32_t size) override {
+    auto bytes = gzread(file_.get(), dst, size);
+    if (bytes < 0) {
+      throw std::invalid_argument(
+          "[bioparser::GzReader] error: invalid file format");
+    }
+    return bytes;
+  }
+
+  void Rewind() override {
+    gzseek(file_.get(), 0, SEEK_SET);
+  }
+
+  // gzip compressed files are inflated up to offset
+  void Seek(std::uint64_t offset) override {
+    if (gzseek(file_.get(), offset, SEEK_SET) == -1) {
+      throw std::invalid_argument(
+          "[bioparser::GzReader] error: unable to seek");
+    }
+  }
+
+ private:
+  std::unique_ptr<gzFile_s, int(*)(gzFile)> file_;
+};
+
+// bytes [begin, end) of another reader, which has to be positioned at begin;
+// offsets are relative to begin
+class RangeReader: public Reader {
+ public:
+  RangeReader(Reader* reader, std::uint64_t begin, std::uint64_t end)
+      : reader_(reader),
+        begin_(begin),
+        end_(std::max(begin, end)),
+        ptr_(0) {}
+
+  std::uint32_t Read(char* dst, std::uint32_t size) override {
+    auto count = std::min<std::uint64_t>(size, end_ - begin_ - ptr_);
+    auto bytes = count == 0 ? 0 : reader_->Read(dst, count);
+    ptr_ += bytes;
+    return bytes;
+  }
+
+  void Rewind() override {
+    Seek(0);
+  }
+
+  void Seek(std::uint64_t offset) override {
+    ptr_ = std::min(offset, end_ - begin_);
+    reader_->Seek(begin_ + ptr_);
+  }
+
+ private:
+  std::unique_ptr<Reader> reader_;
+  std::uint64_t begin_;
+  std::uint64_t end_;
+  std::uint64_t ptr_;
+};
+
+}  // namespace bioparser
+
+#endif  // BIOPARSER_READER_HPP_
@@ -0,0 +1,93 @@
+// Copyright (c) 2026 Robert Vaser
+
+#ifndef BIOPARSER_SAM_HEADER_HPP_
+#define BIOPARSER_SAM_HEADER_HPP_
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "bioparser/numeric.hpp"
+#include "bioparser/scanner.hpp"
+
+namespace bioparser {
+
+// header lines of a SAM file, with the reference sequences of @SQ lines
+// decoded into a dictionary
+class SamHeader {
+ public:
+  struct Reference {
+    std::string name;
+    std::uint64_t length;
+  };
+
+  SamHeader()
+      : text_(),
+        references_(),
+        ids_() {}
+
+  // line excludes the line ending; @SQ lines need SN and LN fields
+  void Add(const char* line, std::uint64_t line_len) {
+    text_.append(line, line_len);
+    text_.push_back('\n');
+    if (line_len < 3 || line[0] != '@' || line[1] != 'S' || line[2] != 'Q') {
+      return;
+    }
+
+    Reference reference{};
+    bool has_length = false;
+    auto last = line + line_len;
+    for (auto it = line + 3; it < last;) {
+      auto first = it + 1;  // skip the tab
+      it = Scanner::FindFirstOf(first, last, '\t', '\t');
+      if (it - first < 3 || first[2] != ':') {
+        continue;
+      }
+      if (first[0] == 'S' && first[1] == 'N') {
+        reference.name.assign(first + 3, it);
+      } else if (first[0] == 'L' && first[1] == 'N') {
+        has_length = Numeric::Parse(first + 3, it, &reference.length);
+      }
+    }
+    if (reference.name.empty() || !has_length) {
+      throw std::invalid_argument(
+          "[bioparser::SamHeader::Add] error: invalid reference line " +
+          std::string(line, line_len));
+    }
+    if (ids_.emplace(reference.name, references_.size()).second) {
+      references_.emplace_back(std::move(reference));
+    }
+  }
+
+  // returns nullptr for unknown names
+  const Reference* Find(const std::string& name) const {
+    auto it = ids_.find(name);
+    return it == ids_.end() ? nullptr : &references_[it->second];
+  }
+
+  // all lines, each followed by a line ending
+  const std::string& text() const {
+    return text_;
+  }
+
+  // in file order, the index equals the reference id of BAM files
+  const std::vector<Reference>& references() const {
+    return references_;
+  }
+
+  bool empty() const {
+    return text_.empty();
+  }
+
+ private:
+  std::string text_;
+  std::vector<Reference> references_;
+  std::unordered_map<std::string, std::uint64_t> ids_;
+};
+
+}  // namespace bioparser
+
+#endif  // BIOPARSER_SAM_HEADER_HPP_
@@ -3,13 +3,16 @@
 #ifndef BIOPARSER_SAM_PARSER_HPP_
 #define BIOPARSER_SAM_PARSER_HPP_
 
+#include <algorithm>
 #include <cstdint>
-#include <cstdlib>
 #include <memory>
 #include <vector>
 #include <stdexcept>
 
+#include "bioparser/numeric.hpp"
 #include "bioparser/parser.hpp"
+#include "bioparser/sam_header.hpp"
+#include "bioparser/tags.hpp"
 
 namespace bioparser {
 
@@ -24,76 +27,90 @@ class SamParser: public Parser<T> {
 
   ~SamParser() {}
 
-  std::vector<std::unique_ptr<T>> Parse(
-      std::uint64_t bytes, bool shorten_names = true) override {
-    std::vector<std::unique_ptr<T>> dst;
+  // returns the header lines, which are parsed first if no record has been
+  // parsed yet; parsers starting in the middle of a file have an empty header
+  const SamHeader& header() {
+    if (!is_header_done_) {
+      is_header_only_ = true;
+      ParseRecords(-1, true);
+      is_header_only_ = false;
+    }
+    return header_;
+  }
+
+ private:
+  std::uint64_t ParseRecords(
+      std::uint64_t bytes, bool shorten_names) override {
+    std::uint64_t num_records = 0;
     std::uint64_t parsed_bytes = 0;
 
     const char* q_name = nullptr;
-    std::uint32_t q_name_len = 0;
+    std::uint64_t q_name_len = 0;
     std::uint32_t flag = 0;
     const char* t_name = nullptr;
-    std::uint32_t t_name_len = 0;
-    std::uint32_t t_begin = 0;
+    std::uint64_t t_name_len = 0;
+    std::uint64_t t_begin = 0;
     std::uint32_t map_quality = 0;
     const char* cigar = nullptr;
-    std::uint32_t cigar_len = 0;
+    std::uint64_t cigar_len = 0;
     const char* t_next_name = nullptr;
-    std::uint32_t t_next_name_len = 0;
-    std::uint32_t t_next_begin = 0;
-    std::uint32_t template_len = 0;
+    std::uint64_t t_next_name_len = 0;
+    std::uint64_t t_next_begin = 0;
+    std::int64_t template_len = 0;  // negative for the rightmost segment
     const char* data = nullptr;
-    std::uint32_t data_len = 0;
+    std::uint64_t data_len = 0;
     const char* quality = nullptr;
-    std::uint32_t quality_len = 0;
+    std::uint64_t quality_len = 0;
 
     auto create_T = [&] () -> void {
-      if (this->storage()[0] == '@') {  // file header
+      auto line = this->Span(0, this->storage_ptr());
+      auto storage_ptr = this->RightStrip(line, this->storage_ptr());
+      if (line[0] == '@') {  // file header
+        if (!is_header_done_) {
+          header_.Add(line, storage_ptr);
+        }
         this->Clear();
         return;
       }
-      auto storage_ptr = this->RightStrip(
-          this->storage().data(),
-          this->storage_ptr());
-      this->Terminate(storage_ptr);
 
+      bool is_valid = true;
       std::uint32_t num_values = 0;
-      std::uint32_t begin_ptr = 0;
+      std::uint64_t begin_ptr = 0;
+      std::uint64_t tags_ptr = 0;
       while (true) {
-        auto end_ptr = begin_ptr;
-        while (end_ptr < storage_ptr && this->storage()[end_ptr] != '\t') {
-          ++end_ptr;
-        }
-        this->Terminate(end_ptr);
+        auto end_ptr = static_cast<std::uint64_t>(Scanner::FindFirstOf(
+            line + begin_ptr, line + storage_ptr, '\t', '\t') - line);
+        auto first = line + begin_ptr;
+        auto last = line + end_ptr;
 
         switch (num_values) {
           case 0:
-            q_name = this->storage().data() + begin_ptr;
+            q_name = line + begin_ptr;
             q_name_len = end_ptr - begin_ptr;
             break;
-          case 1: flag = std::atoi(this->storage().data() + begin_ptr); break;
+          case 1: is_valid &= Numeric::Parse(first, last, &flag); break;
           case 2:
-            t_name = this->storage().data() + begin_ptr;
+            t_name = line + begin_ptr;
             t_name_len = end_ptr - begin_ptr;
             break;
-          case 3: t_begin = std::atoi(this->storage().data() + begin_ptr); break;  // NOLINT
-          case 4: map_quality = std::atoi(this->storage().data() + begin_ptr); break;  // NOLINT
+          case 3: is_valid &= Numeric::Parse(first, last, &t_begin); break;
+          case 4: is_valid &= Numeric::Parse(first, last, &map_quality); break;
           case 5:
-            cigar = this->storage().data() + begin_ptr;
+            cigar = line + begin_ptr;
             cigar_len = end_ptr - begin_ptr;
             break;
           case 6:
-            t_next_name = this->storage().data() + begin_ptr;
+            t_next_name = line + begin_ptr;
             t_next_name_len = end_ptr - begin_ptr;
             break;
-          case 7: t_next_begin = std::atoi(this->storage().data() + begin_ptr); break;  // NOLINT
-          case 8: template_len = std::atoi(this->storage().data() + begin_ptr); break;  // NOLINT
+          case 7: is_valid &= Numeric::Parse(first, last, &t_next_begin); break;
+          case 8: is_valid &= Numeric::Parse(first, last, &template_len); break;
           case 9:
-            data = this->storage().data() + begin_ptr;
+            data = line + begin_ptr;
             data_len = end_ptr - begin_ptr;
             break;
           case 10:
-            quality = this->storage().data() + begin_ptr;
+            quality = line + begin_ptr;
             quality_len = end_ptr - begin_ptr;
             break;
           default: break;
@@ -101,12 +118,13 @@ class SamParser: public Parser<T> {
 
         ++num_values;
         if (end_ptr == storage_ptr || num_values == 11) {
+          tags_ptr = std::min(end_ptr + 1, storage_ptr);  // optional fields
           break;
         }
         begin_ptr = end_ptr + 1;
       }
 
-      if (num_values != 11) {
+      if (!is_valid || num_values != 11) {
         throw std::invalid_argument(
             "[bioparser::SamParser] error: invalid file format");
       }
@@ -135,7 +153,8 @@ class SamParser: public Parser<T> {
             "[bioparser::SamParser] error: invalid file format");
       }
 
-      dst.emplace_back(std::unique_ptr<T>(new T(
+      this->EmitTagged(
+          line + tags_ptr, storage_ptr - tags_ptr,
           q_name, q_name_len,
           flag,
           t_name, t_name_len, t_begin,
@@ -144,7 +163,8 @@ class SamParser: public Parser<T> {
           t_next_name, t_next_name_len, t_next_begin,
           template_len,
           data, data_len,
-          quality, quality_len)));
+          quality, quality_len);
+      ++num_records;
 
       parsed_bytes += this->storage_ptr();
       this->Clear();
@@ -155,14 +175,22 @@ class SamParser: public Parser<T> {
     while (true) {
       auto buffer_ptr = this->buffer_ptr();
       for (; buffer_ptr < this->buffer_bytes(); ++buffer_ptr) {
-        auto c = this->buffer()[buffer_ptr];
-        if (c == '\n') {
-          this->Store(buffer_ptr - this->buffer_ptr());
-          create_T();
-          if (parsed_bytes >= bytes) {
-            return dst;
+        if (!is_header_done_ && this->storage_ptr() == 0 &&
+            this->buffer()[buffer_ptr] != '@') {  // first record
+          is_header_done_ = true;
+          if (is_header_only_) {
+            return num_records;
           }
         }
+        buffer_ptr = this->Find(buffer_ptr, '\n', '\n');
+        if (buffer_ptr == this->buffer_bytes()) {
+          break;
+        }
+        this->Store(buffer_ptr - this->buffer_ptr());
+        create_T();
+        if (parsed_bytes >= bytes) {
+          return num_records;
+        }
       }
       if (this->buffer_ptr() < buffer_ptr) {
         this->Store(buffer_ptr - this->buffer_ptr());
@@ -177,13 +205,20 @@ class SamParser: public Parser<T> {
     if (this->storage_ptr() != 0) {
       create_T();
     }
+    is_header_done_ = true;
 
-    return dst;
+    return num_records;
   }
 
- private:
-  explicit SamParser(gzFile file)
-      : Parser<T>(file, 65536) {}  // 64 kB
+  explicit SamParser(Reader* reader)
+      : Parser<T>(reader, 65536),  // 64 kB
+        header_(),
+        is_header_done_(false),
+        is_header_only_(false) {}
+
+  SamHeader header_;
+  bool is_header_done_;
+  bool is_header_only_;
 
   friend Parser<T>;
 };
@@ -0,0 +1,136 @@
+// Copyright (c) 2026 Robert Vaser
+
+#ifndef BIOPARSER_SCANNER_HPP_
+#define BIOPARSER_SCANNER_HPP_
+
+#include <cstdint>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#if defined(__SSE2__)
+#define BIOPARSER_HAS_SSE2 1
+#endif
+#define BIOPARSER_HAS_AVX2 1  // compiled for the target, selected at runtime
+#elif defined(__GNUC__) && (defined(__aarch64__) || defined(__ARM_NEON))
+#include <arm_neon.h>
+#define BIOPARSER_HAS_NEON 1
+#endif
+
+namespace bioparser {
+
+// locates delimiters with the widest vector kernel supported by the CPU
+class Scanner {
+ public:
+  using Kernel = const char* (*)(const char*, const char*, char, char);
+
+  // returns a pointer to the first byte in [first, last) equal to c0 or c1,
+  // or last if there is none
+  static const char* FindFirstOf(
+      const char* first, const char* last,
+      char c0, char c1) {
+    static const Kernel kernel = Select();
+    return kernel(first, last, c0, c1);
+  }
+
+  static const char* Scalar(
+      const char* first, const char* last,
+      char c0, char c1) {
+    for (; first < last; ++first) {
+      if (*first == c0 || *first == c1) {
+        break;
+      }
+    }
+    return first;
+  }
+
+#if defined(BIOPARSER_HAS_SSE2)
+  static const char* Sse2(
+      const char* first, const char* last,
+      char c0, char c1) {
+    auto v0 = _mm_set1_epi8(c0);
+    auto v1 = _mm_set1_epi8(c1);
+    for (; last - first >= 16; first += 16) {
+      auto x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+      auto mask = _mm_movemask_epi8(_mm_or_si128(
+          _mm_cmpeq_epi8(x, v0),
+          _mm_cmpeq_epi8(x, v1)));
+      if (mask != 0) {
+        return first + __builtin_ctz(mask);
+      }
+    }
+    return Scalar(first, last, c0, c1);
+  }
+#endif
+
+#if defined(BIOPARSER_HAS_AVX2)
+  __attribute__((target("avx2")))
+  static const char* Avx2(
+      const char* first, const char* last,
+      char c0, char c1) {
+    auto v0 = _mm256_set1_epi8(c0);
+    auto v1 = _mm256_set1_epi8(c1);
+    for (; last - first >= 64; first += 64) {  // two vectors per iteration
+      auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+      auto y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + 32));  // NOLINT
+      auto x_mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+          _mm256_or_si256(_mm256_cmpeq_epi8(x, v0), _mm256_cmpeq_epi8(x, v1))));  // NOLINT
+      auto y_mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+          _mm256_or_si256(_mm256_cmpeq_epi8(y, v0), _mm256_cmpeq_epi8(y, v1))));  // NOLINT
+      auto mask = (static_cast<std::uint64_t>(y_mask) << 32) | x_mask;
+      if (mask != 0) {
+        return first + __builtin_ctzll(mask);
+      }
+    }
+    for (; last - first >= 32; first += 32) {
+      auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+      auto mask = _mm256_movemask_epi8(
+          _mm256_or_si256(_mm256_cmpeq_epi8(x, v0), _mm256_cmpeq_epi8(x, v1)));  // NOLINT
+      if (mask != 0) {
+        return first + __builtin_ctz(mask);
+      }
+    }
+    return Scalar(first, last, c0, c1);
+  }
+#endif
+
+#if defined(BIOPARSER_HAS_NEON)
+  static const char* Neon(
+      const char* first, const char* last,
+      char c0, char c1) {
+    auto v0 = vdupq_n_u8(static_cast<std::uint8_t>(c0));
+    auto v1 = vdupq_n_u8(static_cast<std::uint8_t>(c1));
+    for (; last - first >= 16; first += 16) {
+      auto x = vld1q_u8(reinterpret_cast<const std::uint8_t*>(first));
+      auto m = vorrq_u8(vceqq_u8(x, v0), vceqq_u8(x, v1));
+      // narrow each byte of the mask to a nibble
+      auto mask = vget_lane_u64(vreinterpret_u64_u8(
+          vshrn_n_u16(vreinterpretq_u16_u8(m), 4)), 0);
+      if (mask != 0) {
+        return first + (__builtin_ctzll(mask) >> 2);
+      }
+    }
+    return Scalar(first, last, c0, c1);
+  }
+#endif
+
+ private:
+  static Kernel Select() {
+#if defined(BIOPARSER_HAS_AVX2)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+      return &Avx2;
+    }
+#endif
+#if defined(BIOPARSER_HAS_SSE2)
+    return &Sse2;
+#elif defined(BIOPARSER_HAS_NEON)
+    return &Neon;
+#else
+    return &Scalar;
+#endif
+  }
+};
+
+}  // namespace bioparser
+
+#endif  // BIOPARSER_SCANNER_HPP_
@@ -0,0 +1,100 @@
+// Copyright (c) 2026 Robert Vaser
+
+#ifndef BIOPARSER_TAGS_HPP_
+#define BIOPARSER_TAGS_HPP_
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "bioparser/numeric.hpp"
+#include "bioparser/scanner.hpp"
+
+namespace bioparser {
+
+// optional fields of PAF and SAM records (TAG:TYPE:VALUE separated by tabs),
+// which are decoded lazily on lookup; a view into memory owned by the caller
+class Tags {
+ public:
+  struct Tag {
+    // converts values of type i and f
+    template<class N>
+    bool Parse(N* dst) const {
+      return Numeric::Parse(value, value + value_len, dst);
+    }
+
+    const char* name;  // two characters
+    char type;  // one of AifZHB
+    const char* value;
+    std::uint64_t value_len;
+  };
+
+  Tags()
+      : data_(nullptr),
+        data_len_(0) {}
+
+  Tags(const char* data, std::uint64_t data_len)
+      : data_(data),
+        data_len_(data_len) {}
+
+  // returns false if there is no tag with the given two character name, and
+  // throws on malformed fields in front of it
+  bool Find(const char* name, Tag* dst) const {
+    for (std::uint64_t i = 0; i < data_len_;) {
+      i = Next(i, dst);
+      if (dst->name[0] == name[0] && dst->name[1] == name[1]) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::vector<Tag> Decode() const {
+    std::vector<Tag> dst;
+    Tag tag;
+    for (std::uint64_t i = 0; i < data_len_;) {
+      i = Next(i, &tag);
+      dst.emplace_back(tag);
+    }
+    return dst;
+  }
+
+  const char* data() const {
+    return data_;
+  }
+
+  std::uint64_t size() const {
+    return data_len_;
+  }
+
+  bool empty() const {
+    return data_len_ == 0;
+  }
+
+ private:
+  // decodes the field starting at i and returns the start of the next one
+  std::uint64_t Next(std::uint64_t i, Tag* dst) const {
+    auto first = data_ + i;
+    auto last = Scanner::FindFirstOf(first, data_ + data_len_, '\t', '\t');
+    if (last - first < 5 || first[2] != ':' || first[4] != ':' ||
+        std::strchr("AifZHB", first[3]) == nullptr || first[3] == '\0') {
+      throw std::invalid_argument(
+          "[bioparser::Tags] error: invalid tag " +
+          std::string(first, last - first));
+    }
+    dst->name = first;
+    dst->type = first[3];
+    dst->value = first + 5;
+    dst->value_len = last - first - 5;
+    return last - data_ + 1;
+  }
+
+  const char* data_;
+  std::uint64_t data_len_;
+};
+
+}  // namespace bioparser
+
+#endif  // BIOPARSER_TAGS_HPP_
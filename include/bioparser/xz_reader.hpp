@@ -0,0 +1,127 @@
+// Copyright (c) 2026 Robert Vaser
+
+#ifndef BIOPARSER_XZ_READER_HPP_
+#define BIOPARSER_XZ_READER_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(BIOPARSER_USE_LZMA)
+#include "lzma.h"  // NOLINT
+#endif
+
+#include "bioparser/reader.hpp"
+
+namespace bioparser {
+
+// liblzma, decompresses concatenated xz streams; enabled with
+// BIOPARSER_USE_LZMA (bioparser_use_lzma in CMake, lzma in Meson)
+class XzReader: public Reader {
+ public:
+  // returns nullptr if the file is not xz compressed, and throws if it is but
+  // bioparser was built without liblzma
+  static std::unique_ptr<Reader> Open(const std::string& path) {
+    auto file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+      return nullptr;
+    }
+    if (Detect(file) != Compression::kXz) {
+      std::fclose(file);
+      return nullptr;
+    }
+#if defined(BIOPARSER_USE_LZMA)
+    return std::unique_ptr<Reader>(new XzReader(file));
+#else
+    std::fclose(file);
+    throw std::invalid_argument(
+        "[bioparser::XzReader::Open] error: xz support is not enabled");
+#endif
+  }
+
+#if defined(BIOPARSER_USE_LZMA)
+  explicit XzReader(std::FILE* file)
+      : file_(file, std::fclose),
+        strm_(),
+        buffer_(65536),  // 64 kB
+        is_input_eof_(false),
+        is_eof_(false) {
+    Initialize();
+  }
+
+  XzReader(const XzReader&) = delete;
+  XzReader& operator=(const XzReader&) = delete;
+
+  XzReader(XzReader&&) = delete;
+  XzReader& operator=(XzReader&&) = delete;
+
+  ~XzReader() {
+    lzma_end(&strm_);
+  }
+
+  std::uint32_t Read(char* dst, std::uint32_t size) override {
+    strm_.next_out = reinterpret_cast<std::uint8_t*>(dst);
+    strm_.avail_out = size;
+    while (strm_.avail_out > 0 && !is_eof_) {
+      if (strm_.avail_in == 0 && !is_input_eof_) {
+        strm_.next_in = buffer_.data();
+        strm_.avail_in = std::fread(buffer_.data(), 1, buffer_.size(), file_.get());  // NOLINT
+        is_input_eof_ = strm_.avail_in == 0;
+      }
+      auto ret = lzma_code(&strm_, is_input_eof_ ? LZMA_FINISH : LZMA_RUN);
+      if (ret == LZMA_STREAM_END) {
+        is_eof_ = true;
+      } else if (ret != LZMA_OK) {
+        throw std::invalid_argument(
+            "[bioparser::XzReader] error: invalid file format");
+      }
+    }
+    return size - strm_.avail_out;
+  }
+
+  void Rewind() override {
+    lzma_end(&strm_);
+    std::rewind(file_.get());
+    is_input_eof_ = false;
+    is_eof_ = false;
+    Initialize();
+  }
+
+  // decompresses up to offset
+  void Seek(std::uint64_t offset) override {
+    Rewind();
+    while (offset > 0) {
+      auto count = std::min<std::uint64_t>(offset, buffer_.size());
+      std::vector<char> dst(count);
+      if (Read(dst.data(), count) < count) {
+        break;
+      }
+      offset -= count;
+    }
+  }
+
+ private:
+  void Initialize() {
+    lzma_stream strm = LZMA_STREAM_INIT;
+    strm_ = strm;
+    if (lzma_stream_decoder(&strm_, UINT64_MAX, LZMA_CONCATENATED) != LZMA_OK) {  // NOLINT
+      throw std::invalid_argument(
+          "[bioparser::XzReader] error: unable to initialize decoder");
+    }
+  }
+
+  std::unique_ptr<std::FILE, int(*)(std::FILE*)> file_;
+  lzma_stream strm_;
+  std::vector<std::uint8_t> buffer_;
+  bool is_input_eof_;
+  bool is_eof_;
+#endif
+};
+
+}  // namespace bioparser
+
+#endif  // BIOPARSER_XZ_READER_HPP_
@@ -0,0 +1,132 @@
+// Copyright (c) 2026 Robert Vaser
+
+#ifndef BIOPARSER_ZSTD_READER_HPP_
+#define BIOPARSER_ZSTD_READER_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(BIOPARSER_USE_ZSTD)
+#include "zstd.h"  // NOLINT
+#endif
+
+#include "bioparser/reader.hpp"
+
+namespace bioparser {
+
+// libzstd, decompresses concatenated zstd frames; enabled with
+// BIOPARSER_USE_ZSTD (bioparser_use_zstd in CMake, zstd in Meson)
+class ZstdReader: public Reader {
+ public:
+  // returns nullptr if the file is not zstd compressed, and throws if it is
+  // but bioparser was built without libzstd
+  static std::unique_ptr<Reader> Open(const std::string& path) {
+    auto file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+      return nullptr;
+    }
+    if (Detect(file) != Compression::kZstd) {
+      std::fclose(file);
+      return nullptr;
+    }
+#if defined(BIOPARSER_USE_ZSTD)
+    return std::unique_ptr<Reader>(new ZstdReader(file));
+#else
+    std::fclose(file);
+    throw std::invalid_argument(
+        "[bioparser::ZstdReader::Open] error: zstd support is not enabled");
+#endif
+  }
+
+#if defined(BIOPARSER_USE_ZSTD)
+  explicit ZstdReader(std::FILE* file)
+      : file_(file, std::fclose),
+        stream_(ZSTD_createDStream(), ZSTD_freeDStream),
+        buffer_(ZSTD_DStreamInSize()),
+        in_(),
+        is_input_eof_(false),
+        is_frame_end_(true),
+        is_eof_(false) {
+    if (!stream_) {
+      throw std::invalid_argument(
+          "[bioparser::ZstdReader] error: unable to initialize decoder");
+    }
+    Rewind();
+  }
+
+  ZstdReader(const ZstdReader&) = delete;
+  ZstdReader& operator=(const ZstdReader&) = delete;
+
+  ZstdReader(ZstdReader&&) = delete;
+  ZstdReader& operator=(ZstdReader&&) = delete;
+
+  ~ZstdReader() {}
+
+  std::uint32_t Read(char* dst, std::uint32_t size) override {
+    ZSTD_outBuffer out = {dst, size, 0};
+    while (out.pos < out.size && !is_eof_) {
+      if (in_.pos == in_.size && !is_input_eof_) {
+        in_.size = std::fread(buffer_.data(), 1, buffer_.size(), file_.get());
+        in_.pos = 0;
+        is_input_eof_ = in_.size == 0;
+      }
+      auto pos = out.pos;
+      auto ret = ZSTD_decompressStream(stream_.get(), &out, &in_);
+      if (ZSTD_isError(ret)) {
+        throw std::invalid_argument(
+            "[bioparser::ZstdReader] error: invalid file format");
+      }
+      if (is_input_eof_ && out.pos == pos) {  // decoder is drained
+        if (!is_frame_end_) {
+          throw std::invalid_argument(
+              "[bioparser::ZstdReader] error: invalid file format");
+        }
+        is_eof_ = true;
+      } else {
+        is_frame_end_ = ret == 0;
+      }
+    }
+    return out.pos;
+  }
+
+  void Rewind() override {
+    std::rewind(file_.get());
+    ZSTD_initDStream(stream_.get());
+    in_ = {buffer_.data(), 0, 0};
+    is_input_eof_ = false;
+    is_frame_end_ = true;
+    is_eof_ = false;
+  }
+
+  // decompresses up to offset
+  void Seek(std::uint64_t offset) override {
+    Rewind();
+    while (offset > 0) {
+      auto count = std::min<std::uint64_t>(offset, buffer_.size());
+      std::vector<char> dst(count);
+      if (Read(dst.data(), count) < count) {
+        break;
+      }
+      offset -= count;
+    }
+  }
+
+ private:
+  std::unique_ptr<std::FILE, int(*)(std::FILE*)> file_;
+  std::unique_ptr<ZSTD_DStream, std::size_t(*)(ZSTD_DStream*)> stream_;
+  std::vector<char> buffer_;
+  ZSTD_inBuffer in_;
+  bool is_input_eof_;
+  bool is_frame_end_;
+  bool is_eof_;
+#endif
+};
+
+}  // namespace bioparser
+
+#endif  // BIOPARSER_ZSTD_READER_HPP_
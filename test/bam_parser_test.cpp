@@ -0,0 +1,225 @@
+// Copyright (c) 2026 Robert Vaser
+
+#include "bioparser/bam_parser.hpp"
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+
+#include "gtest/gtest.h"
+
+#include "bioparser/sam_parser.hpp"
+#include "bioparser_test_config.h"
+
+namespace bioparser {
+namespace test {
+
+struct Alignment {
+ public:
+  Alignment(
+      const char* q_name, std::uint64_t q_name_len,
+      std::uint32_t flag,
+      const char* t_name, std::uint64_t t_name_len,
+      std::uint64_t t_begin,
+      std::uint32_t map_quality,
+      const char* cigar, std::uint64_t cigar_len,
+      const char* t_next_name, std::uint64_t t_next_name_len,
+      std::uint64_t t_next_begin,
+      std::int64_t template_len,
+      const char* data, std::uint64_t data_len,
+      const char* quality, std::uint64_t quality_len,
+      const char* tags, std::uint64_t tags_len)
+      : q_name(q_name, q_name_len),
+        flag(flag),
+        t_name(t_name, t_name_len),
+        t_begin(t_begin),
+        map_quality(map_quality),
+        cigar(cigar, cigar_len),
+        t_next_name(t_next_name, t_next_name_len),
+        t_next_begin(t_next_begin),
+        template_len(template_len),
+        data(data, data_len),
+        quality(quality, quality_len),
+        tags(tags, tags_len) {}
+
+  std::string q_name;
+  std::uint32_t flag;
+  std::string t_name;
+  std::uint64_t t_begin;
+  std::uint32_t map_quality;
+  std::string cigar;
+  std::string t_next_name;
+  std::uint64_t t_next_begin;
+  std::int64_t template_len;
+  std::string data;
+  std::string quality;
+  std::string tags;
+};
+
+class BioparserBamTest: public ::testing::Test {
+ public:
+  void SetUp() override {
+    auto p = Parser<Alignment>::Create<SamParser>(
+        BIOPARSER_TEST_DATA + std::string("sample.sam"));
+    e = p->Parse(-1);
+    ASSERT_EQ(48, e.size());
+  }
+
+  void Setup(const std::string& file, const Options& options = Options()) {
+    p = Parser<Alignment>::Create<BamParser>(
+        BIOPARSER_TEST_DATA + file,
+        options);
+  }
+
+  void Check() {
+    ASSERT_EQ(e.size(), a.size());
+    for (std::uint32_t i = 0; i < e.size(); ++i) {
+      EXPECT_EQ(e[i]->q_name, a[i]->q_name);
+      EXPECT_EQ(e[i]->flag, a[i]->flag);
+      EXPECT_EQ(e[i]->t_name, a[i]->t_name);
+      EXPECT_EQ(e[i]->t_begin, a[i]->t_begin);
+      EXPECT_EQ(e[i]->map_quality, a[i]->map_quality);
+      EXPECT_EQ(e[i]->cigar, a[i]->cigar);
+      EXPECT_EQ(e[i]->t_next_name, a[i]->t_next_name);
+      EXPECT_EQ(e[i]->t_next_begin, a[i]->t_next_begin);
+      EXPECT_EQ(e[i]->template_len, a[i]->template_len);
+      EXPECT_EQ(e[i]->data, a[i]->data);
+      EXPECT_EQ(e[i]->quality, a[i]->quality);
+
+      // floats are stored in binary, e.g. dv:f:0.1530 becomes dv:f:0.153
+      auto lhs = Tags(e[i]->tags.data(), e[i]->tags.size()).Decode();
+      auto rhs = Tags(a[i]->tags.data(), a[i]->tags.size()).Decode();
+      ASSERT_EQ(lhs.size(), rhs.size());
+      for (std::uint32_t j = 0; j < lhs.size(); ++j) {
+        EXPECT_EQ(std::string(lhs[j].name, 2), std::string(rhs[j].name, 2));
+        EXPECT_EQ(lhs[j].type, rhs[j].type);
+        if (lhs[j].type == 'f') {
+          double l = 0, r = 0;
+          EXPECT_TRUE(lhs[j].Parse(&l) && rhs[j].Parse(&r));
+          EXPECT_FLOAT_EQ(l, r);
+        } else {
+          EXPECT_EQ(
+              std::string(lhs[j].value, lhs[j].value_len),
+              std::string(rhs[j].value, rhs[j].value_len));
+        }
+      }
+    }
+  }
+
+  std::unique_ptr<Parser<Alignment>> p;
+  std::vector<std::unique_ptr<Alignment>> e;  // parsed from SAM
+  std::vector<std::unique_ptr<Alignment>> a;
+};
+
+TEST_F(BioparserBamTest, ParseWhole) {
+  Setup("sample.bam");
+  a = p->Parse(-1);
+  Check();
+}
+
+TEST_F(BioparserBamTest, ParseInChunks) {
+  for (std::uint32_t num_threads : {1, 4}) {
+    Options options;
+    options.num_threads = num_threads;
+    options.read_ahead = num_threads;
+    Setup("sample.bam", options);
+    for (auto t = p->Parse(1024); !t.empty(); t = p->Parse(1024)) {
+      a.insert(
+          a.end(),
+          std::make_move_iterator(t.begin()),
+          std::make_move_iterator(t.end()));
+    }
+    Check();
+    a.clear();
+  }
+}
+
+TEST_F(BioparserBamTest, ParseAndReset) {
+  Setup("sample.bam");
+  p->Parse(100000);
+  p->Reset();
+  a = p->Parse(-1);
+  Check();
+}
+
+TEST_F(BioparserBamTest, Header) {
+  Setup("sample.bam");
+  auto& parser = dynamic_cast<BamParser<Alignment>&>(*p);
+  const auto& header = parser.header();
+  EXPECT_EQ(0, header.text().find("@SQ\tSN:NC_001416.1\tLN:48502\n@PG\t"));
+  ASSERT_EQ(1, header.references().size());
+  EXPECT_EQ(48502, header.Find("NC_001416.1")->length);
+  a = p->Parse(-1);
+  Check();
+
+  Setup("sample.bam");  // restored parsers read the header on their own
+  auto checkpoint = p->Save();
+  p->Parse(100000);
+  checkpoint = p->Save();
+  auto n = p->Parse(-1).size();
+  Setup("sample.bam");
+  p->Restore(checkpoint);
+  EXPECT_EQ(1, dynamic_cast<BamParser<Alignment>&>(*p).header().references().size());  // NOLINT
+  EXPECT_EQ(n, p->Parse(-1).size());
+}
+
+TEST_F(BioparserBamTest, OptionalFields) {
+  auto pack = [] (std::uint32_t value, std::uint32_t size) -> std::string {
+    std::string dst;
+    for (std::uint32_t i = 0; i < size; ++i) {
+      dst.push_back(static_cast<char>(value >> (8 * i)));
+    }
+    return dst;
+  };
+  std::string tags =
+      "XAAx" "XcC" + pack(200, 1) + "Xcc" + pack(-5, 1) +
+      "XsS" + pack(60000, 2) + "Xii" + pack(-70000, 4) +
+      "XZZab c" + std::string(1, '\0') + "XHH1AE3" + std::string(1, '\0') +
+      "XBBs" + pack(2, 4) + pack(-1, 2) + pack(3, 2) +
+      "XfBf" + pack(1, 4) + pack(0x3F000000, 4);  // 0.5
+  std::string record =
+      pack(-1, 4) + pack(-1, 4) + pack(2, 1) + pack(0, 1) + pack(4680, 2) +
+      pack(0, 2) + pack(4, 2) + pack(3, 4) + pack(-1, 4) + pack(-1, 4) +
+      pack(0, 4) + "r" + std::string(1, '\0') +
+      "\x12\xF0" + pack(30, 1) + pack(31, 1) + pack(32, 1) + tags;
+  std::string src = "BAM\1" + pack(0, 4) + pack(0, 4) +
+      pack(record.size(), 4) + record;
+
+  auto path = BIOPARSER_TEST_OUTPUT + std::string("tags.bam");
+  std::ofstream(path, std::ios::binary) << src;  // uncompressed
+  p = Parser<Alignment>::Create<BamParser>(path);
+  a = p->Parse(-1);
+  ASSERT_EQ(1, a.size());
+  EXPECT_EQ("r", a[0]->q_name);
+  EXPECT_EQ("*", a[0]->t_name);
+  EXPECT_EQ(0, a[0]->t_begin);
+  EXPECT_EQ("*", a[0]->cigar);
+  EXPECT_EQ("ACN", a[0]->data);
+  EXPECT_EQ("?@A", a[0]->quality);
+  EXPECT_EQ(
+      "XA:A:x\tXc:i:200\tXc:i:-5\tXs:i:60000\tXi:i:-70000\tXZ:Z:ab c\t"
+      "XH:H:1AE3\tXB:B:s,-1,3\tXf:B:f,0.5",
+      a[0]->tags);
+
+  std::ofstream(path, std::ios::binary) << src.substr(0, src.size() - 3);
+  p = Parser<Alignment>::Create<BamParser>(path);
+  EXPECT_THROW(p->Parse(-1), std::invalid_argument);
+}
+
+TEST_F(BioparserBamTest, FormatError) {
+  Setup("sample.sam.gz");
+  EXPECT_THROW(p->Parse(-1), std::invalid_argument);
+
+  std::ifstream stream(BIOPARSER_TEST_DATA + std::string("sample.bam"));
+  std::string src(
+      (std::istreambuf_iterator<char>(stream)),
+      std::istreambuf_iterator<char>());
+  auto path = BIOPARSER_TEST_OUTPUT + std::string("truncated.bam");
+  std::ofstream(path) << src.substr(0, src.size() / 2);
+  p = Parser<Alignment>::Create<BamParser>(path);
+  EXPECT_THROW(p->Parse(-1), std::invalid_argument);
+}
+
+}  // namespace test
+}  // namespace bioparser
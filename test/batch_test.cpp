@@ -0,0 +1,214 @@
+// Copyright (c) 2026 Robert Vaser
+
+#include "bioparser/batch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <utility>
+
+#include "gtest/gtest.h"
+
+#include "bioparser/fasta_parser.hpp"
+#include "bioparser_test_config.h"
+
+namespace bioparser {
+namespace test {
+
+std::atomic<std::uint64_t> num_allocations{0};
+
+}  // namespace test
+}  // namespace bioparser
+
+// counts all allocations of the test binary
+void* operator new(std::size_t size) {
+  ++bioparser::test::num_allocations;
+  if (auto ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+  return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+namespace bioparser {
+namespace test {
+
+TEST(BioparserArenaTest, Allocate) {
+  Arena arena(256);
+  for (std::size_t alignment : {1, 2, 8, 16, 64}) {
+    auto ptr = arena.Allocate(3, alignment);
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(ptr) % alignment);
+  }
+  EXPECT_EQ(1, arena.num_slabs());
+
+  arena.Allocate(250, 8);
+  EXPECT_EQ(2, arena.num_slabs());
+
+  arena.Clear();
+  for (std::uint32_t i = 0; i < 4; ++i) {
+    arena.Allocate(100, 8);
+  }
+  EXPECT_EQ(2, arena.num_slabs());
+}
+
+TEST(BioparserArenaTest, AllocateOversized) {
+  Arena arena(64);
+  arena.Allocate(16, 8);
+  auto ptr = static_cast<char*>(arena.Allocate(1000, 8));
+  std::fill(ptr, ptr + 1000, 'A');
+  EXPECT_EQ(2, arena.num_slabs());
+
+  arena.Clear();
+  arena.Allocate(1000, 8);  // reuses the oversized slab
+  arena.Allocate(16, 8);
+  arena.Allocate(1000, 8);
+  EXPECT_EQ(3, arena.num_slabs());
+
+  arena.Clear();
+  arena.Allocate(1000, 8);
+  arena.Allocate(1000, 8);
+  arena.Allocate(16, 8);
+  EXPECT_EQ(3, arena.num_slabs());
+}
+
+struct Record {  // counts live objects
+ public:
+  Record(
+      const char* name, std::uint64_t name_len,
+      const char* data, std::uint64_t data_len)
+      : name(name, name_len),
+        data_len(data_len) {
+    (void) data;
+    ++num_objects;
+  }
+
+  ~Record() {
+    --num_objects;
+  }
+
+  std::string name;
+  std::uint64_t data_len;
+
+  static std::int32_t num_objects;
+};
+
+std::int32_t Record::num_objects = 0;
+
+TEST(BioparserBatchTest, Parse) {
+  auto p = Parser<Record>::Create<FastaParser>(
+      BIOPARSER_TEST_DATA + std::string("sample.fasta"));
+  {
+    Batch<Record> b(4096);
+    EXPECT_EQ(14, p->Parse(-1, &b));
+    EXPECT_EQ(14, b.size());
+    EXPECT_EQ(14, Record::num_objects);
+    EXPECT_EQ(1, b.arena().num_slabs());
+
+    std::uint64_t data_len = 0;
+    for (const auto& it : b) {
+      EXPECT_FALSE(it->name.empty());
+      data_len += it->data_len;
+    }
+    EXPECT_EQ(109117, data_len);
+    EXPECT_EQ(b[0].data_len, (*b.begin())->data_len);
+
+    Batch<Record> c(std::move(b));
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(14, c.size());
+
+    p->Reset();
+    EXPECT_EQ(14, p->Parse(-1, &b));
+    EXPECT_EQ(28, Record::num_objects);
+    c = std::move(b);
+    EXPECT_EQ(14, Record::num_objects);
+
+    EXPECT_EQ(0, p->Parse(-1, &c));
+    EXPECT_TRUE(c.empty());
+    EXPECT_TRUE(c.begin() == c.end());
+    EXPECT_EQ(14, Record::num_objects);  // kept for reuse
+
+    p->Reset();
+    data_len = 0;
+    for (std::uint32_t i = 0; i < 14; ++i) {
+      EXPECT_EQ(1, p->Parse(0, &c));
+      EXPECT_EQ(1, c.size());
+      EXPECT_EQ(14, Record::num_objects);
+      data_len += c[0].data_len;
+    }
+    EXPECT_EQ(109117, data_len);
+
+    c.Clear();
+    EXPECT_EQ(0, Record::num_objects);
+  }
+  EXPECT_EQ(0, Record::num_objects);
+}
+
+struct ReusableRecord {
+ public:
+  ReusableRecord(
+      const char* name, std::uint64_t name_len,
+      const char* data, std::uint64_t data_len)
+      : name(name, name_len),
+        data(data, data_len) {}
+
+  void Assign(
+      const char* name, std::uint64_t name_len,
+      const char* data, std::uint64_t data_len) {
+    this->name.assign(name, name_len);
+    this->data.assign(data, data_len);
+  }
+
+  std::string name;
+  std::string data;
+};
+
+TEST(BioparserBatchTest, ParseWithoutAllocations) {
+  auto p = Parser<ReusableRecord>::Create<FastaParser>(
+      BIOPARSER_TEST_DATA + std::string("sample.fasta"));
+
+  Batch<ReusableRecord> b(4096);
+  auto parse = [&] () -> std::uint64_t {
+    std::uint64_t data_len = 0;
+    p->Reset();
+    while (p->Parse(10000, &b) > 0) {
+      for (const auto& it : b) {
+        data_len += it->data.size();
+      }
+    }
+    return data_len;
+  };
+
+  EXPECT_EQ(109117, parse());  // warm up
+
+  auto num_allocations = test::num_allocations.load();
+  auto data_len = parse();
+  num_allocations = test::num_allocations.load() - num_allocations;
+
+  EXPECT_EQ(109117, data_len);
+  EXPECT_EQ(0, num_allocations);
+}
+
+}  // namespace test
+}  // namespace bioparser
@@ -0,0 +1,130 @@
+// Copyright (c) 2026 Robert Vaser
+
+#include "bioparser/bgzf_reader.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "bioparser_test_config.h"
+
+namespace bioparser {
+namespace test {
+
+std::string Inflate(Reader* reader, std::uint32_t chunk_size) {
+  std::string dst;
+  std::vector<char> buffer(chunk_size);
+  while (true) {
+    auto bytes = reader->Read(buffer.data(), buffer.size());
+    dst.append(buffer.data(), bytes);
+    if (bytes < buffer.size()) {
+      break;
+    }
+  }
+  return dst;
+}
+
+TEST(BioparserBgzfReaderTest, Open) {
+  EXPECT_EQ(nullptr, BgzfReader::Open("", 2));
+  EXPECT_EQ(nullptr, BgzfReader::Open(
+      BIOPARSER_TEST_DATA + std::string("sample.fastq"), 2));
+  EXPECT_EQ(nullptr, BgzfReader::Open(
+      BIOPARSER_TEST_DATA + std::string("sample.fastq.gz"), 2));
+  EXPECT_NE(nullptr, BgzfReader::Open(
+      BIOPARSER_TEST_DATA + std::string("sample.fastq.bgz"), 2));
+}
+
+TEST(BioparserBgzfReaderTest, Read) {
+  auto file = gzopen(
+      (BIOPARSER_TEST_DATA + std::string("sample.sam.gz")).c_str(), "r");
+  GzReader gz_reader(file);
+  auto expected = Inflate(&gz_reader, 65536);
+
+  for (std::uint32_t num_threads : {1, 2, 7}) {
+    auto reader = BgzfReader::Open(
+        BIOPARSER_TEST_DATA + std::string("sample.sam.bgz"),
+        num_threads);
+    for (std::uint32_t chunk_size : {1000, 65536, 1 << 20}) {
+      EXPECT_EQ(expected, Inflate(reader.get(), chunk_size));
+      reader->Rewind();
+    }
+  }
+}
+
+TEST(BioparserBgzfReaderTest, Seek) {
+  auto path = BIOPARSER_TEST_DATA + std::string("sample.fasta");
+  std::ifstream stream(path, std::ios::binary);
+  std::string expected(
+      (std::istreambuf_iterator<char>(stream)),
+      std::istreambuf_iterator<char>());
+
+  auto index = BgzfReader::Index(path + ".bgz");  // 4 kB blocks
+  EXPECT_EQ((expected.size() + 4095) / 4096, index->num_blocks());
+  EXPECT_EQ(0, index->Locate(4095).second);
+  EXPECT_EQ(4096, index->Locate(4096).second);
+  EXPECT_EQ(8192, index->Locate(10000).second);
+
+  auto gzi_path = BIOPARSER_TEST_OUTPUT + std::string("sample.fasta.gzi");
+  index->Store(gzi_path);
+  auto loaded = BgzfIndex::Load(gzi_path);
+  ASSERT_NE(nullptr, loaded);
+  EXPECT_EQ(index->num_blocks(), loaded->num_blocks());
+  EXPECT_EQ(index->Locate(10000), loaded->Locate(10000));
+  EXPECT_EQ(nullptr, BgzfIndex::Load(gzi_path + ".missing"));
+
+  for (std::uint32_t num_threads : {1, 2}) {
+    auto reader = BgzfReader::Open(path + ".bgz", num_threads);
+    for (std::uint64_t offset : {100000, 0, 4096, 4095, 77777, 109278}) {
+      reader->Seek(offset);
+      EXPECT_EQ(expected.substr(offset), Inflate(reader.get(), 1000));
+    }
+    reader->Seek(expected.size() + 1);
+    EXPECT_TRUE(Inflate(reader.get(), 1000).empty());
+    reader->Rewind();
+    EXPECT_EQ(expected, Inflate(reader.get(), 65536));
+  }
+}
+
+void CheckInflater(BlockInflater::Backend backend) {
+  std::string data(1000, 'A');
+  std::vector<char> src(compressBound(data.size()));
+  z_stream strm;
+  std::memset(&strm, 0, sizeof(strm));
+  ASSERT_EQ(Z_OK, deflateInit2(&strm, 6, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY));  // NOLINT
+  strm.next_in = reinterpret_cast<Bytef*>(&data[0]);
+  strm.avail_in = data.size();
+  strm.next_out = reinterpret_cast<Bytef*>(src.data());
+  strm.avail_out = src.size();
+  ASSERT_EQ(Z_STREAM_END, deflate(&strm, Z_FINISH));
+  std::uint32_t src_len = strm.total_out;
+  deflateEnd(&strm);
+  std::uint32_t crc = crc32(
+      crc32(0, Z_NULL, 0), reinterpret_cast<Bytef*>(&data[0]), data.size());
+
+  BlockInflater inflater(backend);
+  std::string dst(data.size(), '\0');
+  EXPECT_TRUE(inflater.Inflate(src.data(), src_len, &dst[0], dst.size(), crc));
+  EXPECT_EQ(data, dst);
+  EXPECT_FALSE(inflater.Inflate(src.data(), src_len, &dst[0], dst.size(), ~crc));  // NOLINT
+  EXPECT_FALSE(inflater.Inflate(src.data(), src_len, &dst[0], dst.size() - 1, crc));  // NOLINT
+  EXPECT_FALSE(inflater.Inflate(src.data(), src_len - 1, &dst[0], dst.size(), crc));  // NOLINT
+  EXPECT_TRUE(inflater.Inflate(src.data(), src_len, &dst[0], dst.size(), crc));
+}
+
+TEST(BioparserBgzfReaderTest, InflateBlock) {
+  CheckInflater(BlockInflater::Backend::kZlib);
+#if defined(BIOPARSER_USE_LIBDEFLATE)
+  CheckInflater(BlockInflater::Backend::kLibdeflate);
+#else
+  EXPECT_THROW(
+      BlockInflater(BlockInflater::Backend::kLibdeflate),
+      std::invalid_argument);
+#endif
+}
+
+}  // namespace test
+}  // namespace bioparser
@@ -0,0 +1,64 @@
+// Copyright (c) 2026 Robert Vaser
+
+#include "bioparser/buffer_tuner.hpp"
+
+#include <cstdint>
+
+#include "gtest/gtest.h"
+
+namespace bioparser {
+namespace test {
+
+// reports a window of eight reads at the given throughput in bytes per second
+bool Window(BufferTuner* tuner, double rate) {
+  bool is_changed = false;
+  for (std::uint32_t i = 0; i < 8; ++i) {
+    is_changed = tuner->Update(tuner->size(), tuner->size() / rate);
+  }
+  return is_changed;
+}
+
+TEST(BioparserBufferTunerTest, GrowWhileFaster) {
+  BufferTuner tuner(1U << 16, 1U << 20);
+  EXPECT_EQ(1U << 16, tuner.size());
+  EXPECT_TRUE(Window(&tuner, 100));
+  EXPECT_EQ(1U << 17, tuner.size());
+  EXPECT_TRUE(Window(&tuner, 200));
+  EXPECT_EQ(1U << 18, tuner.size());
+  EXPECT_FALSE(Window(&tuner, 205));  // not worth it, settled
+  EXPECT_EQ(1U << 18, tuner.size());
+  EXPECT_FALSE(Window(&tuner, 1000));
+  EXPECT_EQ(1U << 18, tuner.size());
+}
+
+TEST(BioparserBufferTunerTest, UndoSlowerDoubling) {
+  BufferTuner tuner(1U << 16, 1U << 20);
+  Window(&tuner, 100);
+  EXPECT_EQ(1U << 17, tuner.size());
+  EXPECT_TRUE(Window(&tuner, 50));
+  EXPECT_EQ(1U << 16, tuner.size());
+}
+
+TEST(BioparserBufferTunerTest, MaxSize) {
+  BufferTuner tuner(1U << 16, 1U << 17);
+  Window(&tuner, 100);
+  Window(&tuner, 200);
+  EXPECT_EQ(1U << 17, tuner.size());
+  EXPECT_EQ(1U << 17, BufferTuner(1U << 20, 1U << 17).size());
+}
+
+TEST(BioparserBufferTunerTest, FitRecords) {
+  BufferTuner tuner(1U << 16, 1U << 24);
+  tuner.Observe(1000);
+  tuner.Observe(300000);
+  EXPECT_TRUE(Window(&tuner, 100));
+  EXPECT_EQ(1U << 20, tuner.size());  // holds two records
+  EXPECT_EQ(600000U, tuner.storage_size());
+
+  tuner.Observe(1000);
+  Window(&tuner, 100);
+  EXPECT_EQ(1U << 16, tuner.storage_size());
+}
+
+}  // namespace test
+}  // namespace bioparser
@@ -0,0 +1,102 @@
+// Copyright (c) 2026 Robert Vaser
+
+#include "bioparser/fasta_index.hpp"
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "bioparser_test_config.h"
+
+namespace bioparser {
+namespace test {
+
+void Check(const FastaIndex& index) {
+  ASSERT_EQ(13, index.entries().size());  // second U00096.3 is ignored
+
+  auto entry = index.Find("gi|545778205|gb|U00096.3|");
+  ASSERT_NE(nullptr, entry);
+  EXPECT_EQ(1680, entry->length);
+  EXPECT_EQ(8373, entry->offset);
+  EXPECT_EQ(70, entry->line_bases);
+  EXPECT_EQ(71, entry->line_width);
+  EXPECT_EQ(8373, entry->Offset(0));
+  EXPECT_EQ(8373 + 71 + 1, entry->Offset(71));
+
+  entry = index.Find("12");
+  ASSERT_NE(nullptr, entry);
+  EXPECT_EQ(8716, entry->length);
+  EXPECT_EQ(98945, entry->offset);
+  EXPECT_EQ(8716, entry->line_bases);
+  EXPECT_EQ(8717, entry->line_width);
+
+  EXPECT_EQ(nullptr, index.Find("13"));
+}
+
+TEST(BioparserFastaIndexTest, Build) {
+  for (const auto& it : {"sample.fasta", "sample.fasta.gz", "sample.fasta.bgz"}) {  // NOLINT
+    Check(*FastaIndex::Build(BIOPARSER_TEST_DATA + std::string(it)));
+  }
+  EXPECT_THROW(FastaIndex::Build(""), std::invalid_argument);
+}
+
+TEST(BioparserFastaIndexTest, StoreAndLoad) {
+  auto path = BIOPARSER_TEST_OUTPUT + std::string("sample.fasta.fai");
+  FastaIndex::Build(BIOPARSER_TEST_DATA + std::string("sample.fasta"))->Store(path);  // NOLINT
+
+  std::ifstream stream(path);
+  std::string fai(
+      (std::istreambuf_iterator<char>(stream)),
+      std::istreambuf_iterator<char>());
+  EXPECT_EQ(0, fai.find(
+      "1\t8337\t3\t8337\t8338\n"
+      "gi|545778205|gb|U00096.3|\t1680\t8373\t70\t71\n"
+      "2\t6803\t10080\t6803\t6804\n"));
+
+  auto index = FastaIndex::Load(path);
+  ASSERT_NE(nullptr, index);
+  Check(*index);
+
+  EXPECT_EQ(nullptr, FastaIndex::Load(path + ".missing"));
+  EXPECT_THROW(
+      FastaIndex::Load(BIOPARSER_TEST_DATA + std::string("sample.paf")),
+      std::invalid_argument);
+}
+
+TEST(BioparserFastaIndexTest, LineLengths) {
+  auto path = BIOPARSER_TEST_OUTPUT + std::string("lines.fasta");
+  auto build = [&] (const std::string& src) -> std::unique_ptr<FastaIndex> {
+    std::ofstream(path, std::ios::binary) << src;
+    return FastaIndex::Build(path);
+  };
+
+  auto index = build(">a x\r\nACG\r\nTA\r\n>b\n\nAC\nG\n\n>c\nAC");
+  ASSERT_EQ(3, index->entries().size());
+  const auto& a = index->entries()[0];
+  EXPECT_EQ("a", a.name);
+  EXPECT_EQ(5, a.length);
+  EXPECT_EQ(6, a.offset);
+  EXPECT_EQ(3, a.line_bases);
+  EXPECT_EQ(5, a.line_width);
+  const auto& b = index->entries()[1];
+  EXPECT_EQ(3, b.length);
+  EXPECT_EQ(19, b.offset);
+  EXPECT_EQ(2, b.line_bases);
+  EXPECT_EQ(3, b.line_width);
+  const auto& c = index->entries()[2];
+  EXPECT_EQ(2, c.length);
+  EXPECT_EQ(2, c.line_bases);
+  EXPECT_EQ(3, c.line_width);
+
+  EXPECT_THROW(build(">a\nAC\nACG\n"), std::invalid_argument);
+  EXPECT_THROW(build(">a\nACG\nA\nACG\n"), std::invalid_argument);
+  EXPECT_THROW(build(">a\nACG\n\nACG\n"), std::invalid_argument);
+  EXPECT_THROW(build("ACG\n>a\nACG\n"), std::invalid_argument);
+  EXPECT_THROW(build(">\nACG\n"), std::invalid_argument);
+}
+
+}  // namespace test
+}  // namespace bioparser
@@ -2,7 +2,9 @@
 
 #include "bioparser/fasta_parser.hpp"
 
+#include <algorithm>
 #include <numeric>
+#include <utility>
 
 #include "biosoup/sequence.hpp"
 #include "gtest/gtest.h"
@@ -16,8 +18,10 @@ namespace test {
 
 class BioparserFastaTest: public ::testing::Test {
  public:
-  void Setup(const std::string& file) {
-    p = Parser<biosoup::Sequence>::Create<FastaParser>(BIOPARSER_TEST_DATA + file);
+  void Setup(const std::string& file, const Options& options = Options()) {
+    p = Parser<biosoup::Sequence>::Create<FastaParser>(
+        BIOPARSER_TEST_DATA + file,
+        options);
   }
 
   void Check(bool is_trimmed = true) {
@@ -63,6 +67,28 @@ TEST_F(BioparserFastaTest, ParseInChunks) {
   Check();
 }
 
+TEST_F(BioparserFastaTest, UnmappedParseInChunks) {
+  Options options;
+  options.map_uncompressed = false;
+  Setup("sample.fasta", options);
+  for (auto t = p->Parse(65536); !t.empty(); t = p->Parse(65536)) {
+    s.insert(
+        s.end(),
+        std::make_move_iterator(t.begin()),
+        std::make_move_iterator(t.end()));
+  }
+  Check();
+}
+
+TEST_F(BioparserFastaTest, CallbackParseInChunks) {
+  Setup("sample.fasta");
+  auto callback = [&] (biosoup::Sequence&& it) {
+    s.emplace_back(new biosoup::Sequence(std::move(it)));
+  };
+  while (p->Parse(65536, callback) > 0) {}
+  Check();
+}
+
 TEST_F(BioparserFastaTest, FormatError) {
   Setup("sample.fastq");
   try {
@@ -88,6 +114,31 @@ TEST_F(BioparserFastaTest, ParseAndReset) {
   Check();
 }
 
+TEST_F(BioparserFastaTest, ParseAndRestore) {
+  for (const auto& it : {"sample.fasta", "sample.fasta.gz", "sample.fasta.bgz"}) {  // NOLINT
+    for (std::uint32_t read_ahead : {0, 4}) {
+      Options options;
+      options.read_ahead = read_ahead;
+      options.map_uncompressed = false;
+      Setup(it, options);
+      s = p->Parse(20000);
+      auto checkpoint = p->Save();
+      EXPECT_LT(0, checkpoint.offset);
+      p->Parse(-1);
+
+      p->Restore(checkpoint);
+      for (auto t = p->Parse(20000); !t.empty(); t = p->Parse(20000)) {
+        s.insert(
+            s.end(),
+            std::make_move_iterator(t.begin()),
+            std::make_move_iterator(t.end()));
+      }
+      Check();
+      s.clear();
+    }
+  }
+}
+
 TEST_F(BioparserFastaTest, CompressedParseWhole) {
   Setup("sample.fasta.gz");
   s = p->Parse(-1);
@@ -136,5 +187,166 @@ TEST_F(BioparserFastaTest, CompressedFormatError) {
   }
 }
 
+TEST_F(BioparserFastaTest, AsyncParseInChunks) {
+  Options options;
+  options.read_ahead = 4;
+  Setup("sample.fasta.gz", options);
+  for (auto t = p->Parse(65536); !t.empty(); t = p->Parse(65536)) {
+    s.insert(
+        s.end(),
+        std::make_move_iterator(t.begin()),
+        std::make_move_iterator(t.end()));
+  }
+  Check();
+}
+
+TEST_F(BioparserFastaTest, AsyncParseAndReset) {
+  Options options;
+  options.read_ahead = 1;
+  Setup("sample.fasta.gz", options);
+  s = p->Parse(-1);
+  p->Reset();
+  s.clear();
+  for (auto t = p->Parse(65536); !t.empty(); t = p->Parse(65536)) {
+    s.insert(
+        s.end(),
+        std::make_move_iterator(t.begin()),
+        std::make_move_iterator(t.end()));
+  }
+  Check();
+}
+
+TEST_F(BioparserFastaTest, ParallelParseWhole) {
+  Options options;
+  options.num_threads = 4;
+  Setup("sample.fasta", options);
+  s = p->Parse(-1);
+  Check();
+}
+
+TEST_F(BioparserFastaTest, ParallelParseInChunks) {
+  Setup("sample.fasta");
+  auto expected = p->Parse(-1);
+
+  for (std::uint32_t num_threads : {2, 3, 7, 16, 64}) {
+    for (std::uint64_t bytes : {0, 1000, 30000, 65536}) {
+      Options options;
+      options.num_threads = num_threads;
+      Setup("sample.fasta", options);
+      s.clear();
+      for (auto t = p->Parse(bytes); !t.empty(); t = p->Parse(bytes)) {
+        s.insert(
+            s.end(),
+            std::make_move_iterator(t.begin()),
+            std::make_move_iterator(t.end()));
+      }
+      ASSERT_EQ(expected.size(), s.size());
+      for (std::uint32_t i = 0; i < s.size(); ++i) {
+        EXPECT_EQ(expected[i]->name, s[i]->name);
+        EXPECT_EQ(expected[i]->data, s[i]->data);
+      }
+    }
+  }
+}
+
+TEST_F(BioparserFastaTest, ParallelParseAndReset) {
+  Options options;
+  options.num_threads = 4;
+  Setup("sample.fasta", options);
+  s = p->Parse(10000);
+  p->Reset();
+  s = p->Parse(-1);
+  Check();
+}
+
+TEST_F(BioparserFastaTest, ParallelFormatError) {
+  Options options;
+  options.num_threads = 4;
+  Setup("sample.fastq", options);
+  try {
+    s = p->Parse(-1);
+  } catch (std::invalid_argument& exception) {
+    EXPECT_STREQ(
+        exception.what(),
+        "[bioparser::FastaParser] error: invalid file format");
+  }
+}
+
+struct SequenceView {  // points into parser buffers
+ public:
+  SequenceView(
+      const char* name, std::uint64_t name_len,
+      const char* data, std::uint64_t data_len)
+      : name(name),
+        name_len(name_len),
+        data(data),
+        data_len(data_len) {}
+
+  const char* name;
+  std::uint64_t name_len;
+  const char* data;
+  std::uint64_t data_len;
+};
+
+TEST_F(BioparserFastaTest, Fetch) {
+  Setup("sample.fasta");
+  auto expected = p->Parse(-1);
+  const auto& head = expected[1];  // lines of 70 bases
+  const auto& last = expected[12];
+
+  for (const auto& it : {"sample.fasta", "sample.fasta.gz", "sample.fasta.bgz"}) {  // NOLINT
+    for (bool map_uncompressed : {true, false}) {
+      Options options;
+      options.map_uncompressed = map_uncompressed;
+      Setup(it, options);
+      s = p->Parse(20000);  // Fetch() does not interfere with Parse()
+
+      for (const auto& jt : std::vector<std::pair<std::uint64_t, std::uint64_t>>{  // NOLINT
+          {0, 1680}, {69, 71}, {70, 141}, {1000, 5000}, {1679, 1680}}) {
+        auto t = p->Fetch(head->name, jt.first, jt.second);
+        EXPECT_EQ(head->name, t->name);
+        EXPECT_EQ(head->data.substr(jt.first, jt.second - jt.first), t->data);
+      }
+      EXPECT_EQ(last->data, p->Fetch(last->name, 0, -1)->data);
+      EXPECT_EQ(last->data.substr(8000), p->Fetch("12", 8000, -1)->data);
+      EXPECT_THROW(p->Fetch("13", 0, 1), std::invalid_argument);
+      EXPECT_THROW(p->Fetch("12", 10, 10), std::invalid_argument);
+      EXPECT_THROW(p->Fetch("12", 8716, -1), std::invalid_argument);
+
+      for (auto t = p->Parse(20000); !t.empty(); t = p->Parse(20000)) {
+        s.insert(
+            s.end(),
+            std::make_move_iterator(t.begin()),
+            std::make_move_iterator(t.end()));
+      }
+      Check();
+      s.clear();
+    }
+  }
+}
+
+TEST(BioparserFastaViewTest, CallbackParseWhole) {
+  for (bool map_uncompressed : {true, false}) {
+    Options options;
+    options.map_uncompressed = map_uncompressed;
+    auto p = Parser<SequenceView>::Create<FastaParser>(
+        BIOPARSER_TEST_DATA + std::string("sample.fasta"),
+        options);
+    std::uint64_t name_len = 0;
+    std::uint64_t data_len = 0;
+    std::uint64_t num_gc = 0;
+    EXPECT_EQ(14, p->Parse(-1, [&] (SequenceView&& it) {
+      name_len += it.name_len;
+      data_len += it.data_len;
+      num_gc += std::count(it.data, it.data + it.data_len, 'G') +
+          std::count(it.data, it.data + it.data_len, 'C');
+    }));
+    EXPECT_EQ(65, name_len);
+    EXPECT_EQ(109117, data_len);
+    EXPECT_LT(0, num_gc);
+    EXPECT_EQ(0, p->Parse(-1, [] (SequenceView&&) {}));
+  }
+}
+
 }  // namespace test
 }  // namespace bioparser
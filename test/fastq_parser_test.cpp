@@ -3,6 +3,7 @@
 #include "bioparser/fastq_parser.hpp"
 
 #include <numeric>
+#include <utility>
 
 #include "biosoup/sequence.hpp"
 #include "gtest/gtest.h"
@@ -14,8 +15,10 @@ namespace test {
 
 class BioparserFastqTest: public ::testing::Test {
  public:
-  void Setup(const std::string& file) {
-    p = Parser<biosoup::Sequence>::Create<FastqParser>(BIOPARSER_TEST_DATA + file);
+  void Setup(const std::string& file, const Options& options = Options()) {
+    p = Parser<biosoup::Sequence>::Create<FastqParser>(
+        BIOPARSER_TEST_DATA + file,
+        options);
   }
 
   void Check() {
@@ -44,6 +47,11 @@ TEST_F(BioparserFastqTest, ParseWhole) {
   Check();
 }
 
+TEST_F(BioparserFastqTest, Fetch) {
+  Setup("sample.fastq");
+  EXPECT_THROW(p->Fetch("1", 0, 1), std::invalid_argument);
+}
+
 TEST_F(BioparserFastqTest, ParseInChunks) {
   Setup("sample.fastq");
   for (auto t = p->Parse(65536); !t.empty(); t = p->Parse(65536)) {
@@ -55,6 +63,75 @@ TEST_F(BioparserFastqTest, ParseInChunks) {
   Check();
 }
 
+TEST_F(BioparserFastqTest, UnmappedParseInChunks) {
+  Options options;
+  options.map_uncompressed = false;
+  Setup("sample.fastq", options);
+  for (auto t = p->Parse(65536); !t.empty(); t = p->Parse(65536)) {
+    s.insert(
+        s.end(),
+        std::make_move_iterator(t.begin()),
+        std::make_move_iterator(t.end()));
+  }
+  Check();
+}
+
+TEST_F(BioparserFastqTest, CallbackParseInChunks) {
+  Setup("sample.fastq");
+  auto callback = [&] (biosoup::Sequence&& it) {
+    s.emplace_back(new biosoup::Sequence(std::move(it)));
+  };
+  while (p->Parse(65536, callback) > 0) {}
+  Check();
+}
+
+TEST_F(BioparserFastqTest, SaveAndRestore) {
+  auto path = BIOPARSER_TEST_OUTPUT + std::string("sample.fastq.ckp");
+  for (const auto& it : {"sample.fastq", "sample.fastq.gz", "sample.fastq.bgz"}) {  // NOLINT
+    for (std::uint32_t num_threads : {1, 2}) {
+      Options options;
+      options.num_threads = num_threads;
+      options.read_ahead = num_threads == 1 ? 0 : 4;
+      Setup(it, options);
+      s = p->Parse(20000);
+      p->Save().Store(path);
+      p->Parse(20000);  // lost on preemption
+
+      Setup(it, options);
+      auto checkpoint = Checkpoint::Load(path);
+      ASSERT_NE(nullptr, checkpoint);
+      p->Restore(*checkpoint);
+      for (auto t = p->Parse(20000); !t.empty(); t = p->Parse(20000)) {
+        s.insert(
+            s.end(),
+            std::make_move_iterator(t.begin()),
+            std::make_move_iterator(t.end()));
+      }
+      Check();
+      s.clear();
+    }
+  }
+}
+
+TEST_F(BioparserFastqTest, IndexedParseInRanges) {
+  auto path = BIOPARSER_TEST_DATA + std::string("sample.fastq.gz");
+  auto index = GzipIndex::Build(path, 16384);
+  for (std::uint64_t num_ranges : {1, 4, 50}) {
+    auto range_size = index->size() / num_ranges + 1;
+    for (std::uint64_t i = 0; i < num_ranges; ++i) {
+      p = Parser<biosoup::Sequence>::Create<FastqParser>(
+          path, *index, i * range_size, (i + 1) * range_size);
+      auto t = p->Parse(-1);
+      s.insert(
+          s.end(),
+          std::make_move_iterator(t.begin()),
+          std::make_move_iterator(t.end()));
+    }
+    Check();
+    s.clear();
+  }
+}
+
 TEST_F(BioparserFastqTest, FormatError) {
   Setup("sample.fasta");
   try {
@@ -94,5 +171,229 @@ TEST_F(BioparserFastqTest, CompressedFormatError) {
   }
 }
 
+#if defined(BIOPARSER_USE_LZMA)
+TEST_F(BioparserFastqTest, XzParseInChunks) {
+  Setup("sample.fastq.xz");  // two concatenated streams
+  for (auto t = p->Parse(65536); !t.empty(); t = p->Parse(65536)) {
+    s.insert(
+        s.end(),
+        std::make_move_iterator(t.begin()),
+        std::make_move_iterator(t.end()));
+  }
+  Check();
+}
+
+TEST_F(BioparserFastqTest, XzAsyncParseAndReset) {
+  Options options;
+  options.read_ahead = 2;
+  Setup("sample.fastq.xz", options);
+  s = p->Parse(-1);
+  p->Reset();
+  s.clear();
+  s = p->Parse(-1);
+  Check();
+}
+#else
+TEST_F(BioparserFastqTest, XzNotEnabled) {
+  try {
+    Setup("sample.fastq.xz");
+  } catch (std::invalid_argument& exception) {
+    EXPECT_STREQ(
+        exception.what(),
+        "[bioparser::XzReader::Open] error: xz support is not enabled");
+  }
+}
+#endif
+
+#if defined(BIOPARSER_USE_ZSTD)
+TEST_F(BioparserFastqTest, ZstdParseInChunks) {
+  Setup("sample.fastq.zst");  // two concatenated frames
+  for (auto t = p->Parse(65536); !t.empty(); t = p->Parse(65536)) {
+    s.insert(
+        s.end(),
+        std::make_move_iterator(t.begin()),
+        std::make_move_iterator(t.end()));
+  }
+  Check();
+}
+
+TEST_F(BioparserFastqTest, ZstdAsyncParseAndReset) {
+  Options options;
+  options.read_ahead = 2;
+  Setup("sample.fastq.zst", options);
+  s = p->Parse(-1);
+  p->Reset();
+  s.clear();
+  s = p->Parse(-1);
+  Check();
+}
+#else
+TEST_F(BioparserFastqTest, ZstdNotEnabled) {
+  try {
+    Setup("sample.fastq.zst");
+  } catch (std::invalid_argument& exception) {
+    EXPECT_STREQ(
+        exception.what(),
+        "[bioparser::ZstdReader::Open] error: zstd support is not enabled");
+  }
+}
+#endif
+
+TEST_F(BioparserFastqTest, SmallBuffersParseInChunks) {
+  Options options;
+  options.buffer_size = 1000;
+  options.storage_size = 10;
+  Setup("sample.fastq.gz", options);
+  for (auto t = p->Parse(65536); !t.empty(); t = p->Parse(65536)) {
+    s.insert(
+        s.end(),
+        std::make_move_iterator(t.begin()),
+        std::make_move_iterator(t.end()));
+  }
+  Check();
+}
+
+TEST_F(BioparserFastqTest, AdaptiveBuffersParseInChunks) {
+  Options options;
+  options.buffer_size = 1000;  // shorter than records
+  options.adaptive_buffers = true;
+  Setup("sample.fastq.gz", options);
+  for (auto t = p->Parse(1000); !t.empty(); t = p->Parse(1000)) {
+    s.insert(
+        s.end(),
+        std::make_move_iterator(t.begin()),
+        std::make_move_iterator(t.end()));
+  }
+  Check();
+}
+
+TEST_F(BioparserFastqTest, AdaptiveBuffersAsyncParseAndReset) {
+  Options options;
+  options.buffer_size = 1000;
+  options.adaptive_buffers = true;
+  options.read_ahead = 2;
+  Setup("sample.fastq.gz", options);
+  s = p->Parse(-1);
+  p->Reset();
+  s.clear();
+  for (auto t = p->Parse(1000); !t.empty(); t = p->Parse(1000)) {
+    s.insert(
+        s.end(),
+        std::make_move_iterator(t.begin()),
+        std::make_move_iterator(t.end()));
+  }
+  Check();
+}
+
+TEST_F(BioparserFastqTest, AsyncParseInChunks) {
+  Options options;
+  options.read_ahead = 4;
+  Setup("sample.fastq.gz", options);
+  for (auto t = p->Parse(65536); !t.empty(); t = p->Parse(65536)) {
+    s.insert(
+        s.end(),
+        std::make_move_iterator(t.begin()),
+        std::make_move_iterator(t.end()));
+  }
+  Check();
+}
+
+TEST_F(BioparserFastqTest, AsyncParseAndReset) {
+  Options options;
+  options.read_ahead = 1;
+  Setup("sample.fastq.gz", options);
+  s = p->Parse(-1);
+  p->Reset();
+  s.clear();
+  for (auto t = p->Parse(65536); !t.empty(); t = p->Parse(65536)) {
+    s.insert(
+        s.end(),
+        std::make_move_iterator(t.begin()),
+        std::make_move_iterator(t.end()));
+  }
+  Check();
+}
+
+TEST_F(BioparserFastqTest, BgzfParseInChunks) {
+  Options options;
+  options.num_threads = 4;
+  Setup("sample.fastq.bgz", options);
+  for (auto t = p->Parse(65536); !t.empty(); t = p->Parse(65536)) {
+    s.insert(
+        s.end(),
+        std::make_move_iterator(t.begin()),
+        std::make_move_iterator(t.end()));
+  }
+  Check();
+}
+
+TEST_F(BioparserFastqTest, BgzfAsyncParseAndReset) {
+  Options options;
+  options.read_ahead = 2;
+  options.num_threads = 2;
+  Setup("sample.fastq.bgz", options);
+  s = p->Parse(-1);
+  p->Reset();
+  s.clear();
+  s = p->Parse(-1);
+  Check();
+}
+
+TEST_F(BioparserFastqTest, ParallelParseWhole) {
+  Options options;
+  options.num_threads = 4;
+  Setup("sample.fastq", options);
+  s = p->Parse(-1);
+  Check();
+}
+
+TEST_F(BioparserFastqTest, ParallelParseInChunks) {
+  Setup("sample.fastq");
+  auto expected = p->Parse(-1);
+
+  for (std::uint32_t num_threads : {2, 3, 7, 16, 64}) {
+    for (std::uint64_t bytes : {0, 1000, 30000, 65536}) {
+      Options options;
+      options.num_threads = num_threads;
+      Setup("sample.fastq", options);
+      s.clear();
+      for (auto t = p->Parse(bytes); !t.empty(); t = p->Parse(bytes)) {
+        s.insert(
+            s.end(),
+            std::make_move_iterator(t.begin()),
+            std::make_move_iterator(t.end()));
+      }
+      ASSERT_EQ(expected.size(), s.size());
+      for (std::uint32_t i = 0; i < s.size(); ++i) {
+        EXPECT_EQ(expected[i]->name, s[i]->name);
+        EXPECT_EQ(expected[i]->data, s[i]->data);
+      }
+    }
+  }
+}
+
+TEST_F(BioparserFastqTest, ParallelParseAndReset) {
+  Options options;
+  options.num_threads = 4;
+  Setup("sample.fastq", options);
+  s = p->Parse(10000);
+  p->Reset();
+  s = p->Parse(-1);
+  Check();
+}
+
+TEST_F(BioparserFastqTest, ParallelFormatError) {
+  Options options;
+  options.num_threads = 4;
+  Setup("sample.fasta", options);
+  try {
+    s = p->Parse(-1);
+  } catch (std::invalid_argument& exception) {
+    EXPECT_STREQ(
+        exception.what(),
+        "[bioparser::FastqParser] error: invalid file format");
+  }
+}
+
 }  // namespace test
 }  // namespace bioparser
@@ -0,0 +1,61 @@
+// Copyright (c) 2026 Robert Vaser
+
+#include "bioparser/gzip_index.hpp"
+
+#include <stdexcept>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "bioparser_test_config.h"
+
+namespace bioparser {
+namespace test {
+
+TEST(BioparserGzipIndexTest, Build) {
+  for (const auto& it : {"sample.sam.gz", "sample.sam.bgz"}) {
+    auto index = GzipIndex::Build(
+        BIOPARSER_TEST_DATA + std::string(it), 65536);
+    EXPECT_EQ(799448, index->size());
+    ASSERT_LT(4, index->points().size());
+    for (const auto& jt : index->points()) {
+      EXPECT_LT(0, jt.compressed_offset);
+      EXPECT_GE(32768, jt.window.size());
+      EXPECT_EQ(&jt, &index->Locate(jt.offset));
+      EXPECT_EQ(&jt, &index->Locate(jt.offset + 1));
+    }
+    EXPECT_EQ(0, index->Locate(0).compressed_offset);
+  }
+  EXPECT_THROW(GzipIndex::Build(""), std::invalid_argument);
+  EXPECT_THROW(
+      GzipIndex::Build(BIOPARSER_TEST_DATA + std::string("sample.sam")),
+      std::invalid_argument);
+}
+
+TEST(BioparserGzipIndexTest, StoreAndLoad) {
+  auto path = BIOPARSER_TEST_OUTPUT + std::string("sample.sam.gzx");
+  auto index = GzipIndex::Build(
+      BIOPARSER_TEST_DATA + std::string("sample.sam.gz"), 65536);
+  index->Store(path);
+
+  auto other = GzipIndex::Load(path);
+  ASSERT_NE(nullptr, other);
+  EXPECT_EQ(index->size(), other->size());
+  ASSERT_EQ(index->points().size(), other->points().size());
+  for (std::uint32_t i = 0; i < index->points().size(); ++i) {
+    const auto& lhs = index->points()[i];
+    const auto& rhs = other->points()[i];
+    EXPECT_EQ(lhs.compressed_offset, rhs.compressed_offset);
+    EXPECT_EQ(lhs.bits, rhs.bits);
+    EXPECT_EQ(lhs.offset, rhs.offset);
+    EXPECT_EQ(lhs.window, rhs.window);
+  }
+
+  EXPECT_EQ(nullptr, GzipIndex::Load(path + ".missing"));
+  EXPECT_THROW(
+      GzipIndex::Load(BIOPARSER_TEST_DATA + std::string("sample.sam")),
+      std::invalid_argument);
+}
+
+}  // namespace test
+}  // namespace bioparser
@@ -0,0 +1,107 @@
+// Copyright (c) 2026 Robert Vaser
+
+#include "bioparser/inflate_reader.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "bioparser_test_config.h"
+
+namespace bioparser {
+namespace test {
+
+std::string InflateAll(Reader* reader, std::uint32_t chunk_size) {
+  std::string dst;
+  std::vector<char> buffer(chunk_size);
+  while (true) {
+    auto bytes = reader->Read(buffer.data(), buffer.size());
+    dst.append(buffer.data(), bytes);
+    if (bytes < buffer.size()) {
+      break;
+    }
+  }
+  return dst;
+}
+
+std::string Expected(const std::string& file) {
+  std::ifstream stream(BIOPARSER_TEST_DATA + file, std::ios::binary);
+  return std::string(
+      (std::istreambuf_iterator<char>(stream)),
+      std::istreambuf_iterator<char>());
+}
+
+std::unique_ptr<InflateReader> Open(
+    const std::string& file,
+    std::uint64_t span) {
+  return std::unique_ptr<InflateReader>(new InflateReader(
+      std::fopen((BIOPARSER_TEST_DATA + file).c_str(), "rb"), span));
+}
+
+TEST(BioparserInflateReaderTest, Open) {
+  EXPECT_EQ(nullptr, InflateReader::Open(""));
+  EXPECT_EQ(nullptr, InflateReader::Open(
+      BIOPARSER_TEST_DATA + std::string("sample.sam")));
+  EXPECT_NE(nullptr, InflateReader::Open(
+      BIOPARSER_TEST_DATA + std::string("sample.sam.gz")));
+  EXPECT_NE(nullptr, InflateReader::Open(
+      BIOPARSER_TEST_DATA + std::string("sample.sam.bgz")));
+}
+
+TEST(BioparserInflateReaderTest, Read) {
+  auto expected = Expected("sample.sam");
+  for (const auto& it : {"sample.sam.gz", "sample.sam.bgz"}) {
+    auto reader = InflateReader::Open(BIOPARSER_TEST_DATA + std::string(it));
+    for (std::uint32_t chunk_size : {1000, 65536, 1 << 20}) {
+      EXPECT_EQ(expected, InflateAll(reader.get(), chunk_size));
+      reader->Rewind();
+    }
+  }
+}
+
+TEST(BioparserInflateReaderTest, Seek) {
+  auto expected = Expected("sample.sam");
+  for (const auto& it : {"sample.sam.gz", "sample.sam.bgz"}) {
+    auto reader = Open(it, 16384);
+    EXPECT_EQ(expected, InflateAll(reader.get(), 65536));
+
+    for (std::uint64_t offset : {799000, 700001, 555555, 0, 799448}) {
+      auto point = reader->Locate(offset);
+      EXPECT_LE(point.offset, offset);
+      if (offset > 600000) {
+        EXPECT_LT(0, point.compressed_offset);
+        EXPECT_LT(offset - point.offset, 1 << 17);
+      }
+
+      reader->Seek(offset);
+      EXPECT_EQ(expected.substr(offset), InflateAll(reader.get(), 1000));
+
+      auto other = Open(it, 0);  // restarted from another reader's point
+      other->Restore(point, offset);
+      EXPECT_EQ(expected.substr(offset), InflateAll(other.get(), 65536));
+    }
+    EXPECT_THROW(
+        reader->Restore(reader->Locate(799000), 0),
+        std::invalid_argument);
+  }
+}
+
+TEST(BioparserInflateReaderTest, Truncated) {
+  auto src = Expected("sample.sam.gz");
+  auto path = BIOPARSER_TEST_OUTPUT + std::string("truncated.sam.gz");
+  std::ofstream(path, std::ios::binary) << src.substr(0, src.size() / 2);
+  auto reader = InflateReader::Open(path);
+  EXPECT_THROW(InflateAll(reader.get(), 65536), std::invalid_argument);
+
+  std::ofstream(path, std::ios::binary) << src << "garbage";
+  reader = InflateReader::Open(path);
+  EXPECT_EQ(Expected("sample.sam"), InflateAll(reader.get(), 65536));
+}
+
+}  // namespace test
+}  // namespace bioparser
@@ -4,6 +4,7 @@
 
 #include <numeric>
 #include <string>
+#include <utility>
 
 #include "biosoup/overlap.hpp"
 #include "gtest/gtest.h"
@@ -82,6 +83,15 @@ TEST_F(BioparserMhapTest, ParseInChunks) {
   Check();
 }
 
+TEST_F(BioparserMhapTest, CallbackParseInChunks) {
+  Setup("sample.mhap");
+  auto callback = [&] (MhapOverlap&& it) {
+    o.emplace_back(new MhapOverlap(std::move(it)));
+  };
+  while (p->Parse(1024, callback) > 0) {}
+  Check();
+}
+
 TEST_F(BioparserMhapTest, FormatError) {
   Setup("sample.paf");
   try {
@@ -0,0 +1,60 @@
+// Copyright (c) 2026 Robert Vaser
+
+#include "bioparser/mmap_reader.hpp"
+
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "bioparser_test_config.h"
+
+namespace bioparser {
+namespace test {
+
+TEST(BioparserMmapReaderTest, Open) {
+  EXPECT_EQ(nullptr, MmapReader::Open(""));
+  EXPECT_EQ(nullptr, MmapReader::Open(BIOPARSER_TEST_DATA));
+  EXPECT_EQ(nullptr, MmapReader::Open(
+      BIOPARSER_TEST_DATA + std::string("sample.paf.gz")));
+  EXPECT_EQ(nullptr, MmapReader::Open(
+      BIOPARSER_TEST_DATA + std::string("sample.fastq.xz")));
+}
+
+TEST(BioparserMmapReaderTest, Detect) {
+  EXPECT_EQ(Reader::Compression::kNone, Reader::Detect("@r1\n", 4));
+  EXPECT_EQ(Reader::Compression::kGzip, Reader::Detect("\x1F\x8B", 2));
+  EXPECT_EQ(Reader::Compression::kXz, Reader::Detect("\xFD" "7zXZ\0", 6));
+  EXPECT_EQ(Reader::Compression::kNone, Reader::Detect("\xFD" "7zXZ", 5));
+  EXPECT_EQ(Reader::Compression::kZstd, Reader::Detect("\x28\xB5\x2F\xFD", 4));  // NOLINT
+}
+
+TEST(BioparserMmapReaderTest, Map) {
+  auto path = BIOPARSER_TEST_DATA + std::string("sample.paf");
+  std::ifstream stream(path, std::ios::binary);
+  std::string expected(
+      (std::istreambuf_iterator<char>(stream)),
+      std::istreambuf_iterator<char>());
+
+  auto reader = MmapReader::Open(path);
+  ASSERT_NE(nullptr, reader);
+  auto mmap_reader = static_cast<MmapReader*>(reader.get());
+  EXPECT_EQ(expected.size(), mmap_reader->size());
+
+  std::string mapped;
+  const char* data = nullptr;
+  for (std::uint32_t bytes; (bytes = mmap_reader->Map(&data, 1000)) > 0;) {
+    EXPECT_EQ(mmap_reader->data() + mapped.size(), data);
+    mapped.append(data, bytes);
+  }
+  EXPECT_EQ(expected, mapped);
+
+  mmap_reader->Rewind();
+  std::string read(expected.size(), '\0');
+  EXPECT_EQ(expected.size(), mmap_reader->Read(&read[0], read.size() + 1));
+  EXPECT_EQ(expected, read);
+}
+
+}  // namespace test
+}  // namespace bioparser
@@ -0,0 +1,101 @@
+// Copyright (c) 2026 Robert Vaser
+
+#include "bioparser/numeric.hpp"
+
+#include <cstdint>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace bioparser {
+namespace test {
+
+template<class T>
+bool Parse(const std::string& str, T* dst) {
+  return Numeric::Parse(str.data(), str.data() + str.size(), dst);
+}
+
+TEST(BioparserNumericTest, Unsigned) {
+  std::uint32_t u32 = 0;
+  EXPECT_TRUE(Parse("0", &u32));
+  EXPECT_EQ(0U, u32);
+  EXPECT_TRUE(Parse("7", &u32));
+  EXPECT_EQ(7U, u32);
+  EXPECT_TRUE(Parse("12345678", &u32));
+  EXPECT_EQ(12345678U, u32);
+  EXPECT_TRUE(Parse("000000000000000000000042", &u32));
+  EXPECT_EQ(42U, u32);
+  EXPECT_TRUE(Parse("4294967295", &u32));
+  EXPECT_EQ(4294967295U, u32);
+  EXPECT_FALSE(Parse("4294967296", &u32));
+  EXPECT_FALSE(Parse("", &u32));
+  EXPECT_FALSE(Parse("-1", &u32));
+  EXPECT_FALSE(Parse("+1", &u32));
+  EXPECT_FALSE(Parse(" 1", &u32));
+  EXPECT_FALSE(Parse("1 ", &u32));
+  EXPECT_FALSE(Parse("12a45678", &u32));
+  EXPECT_FALSE(Parse("1234567/", &u32));
+  EXPECT_FALSE(Parse("1234567:", &u32));
+
+  std::uint64_t u64 = 0;
+  EXPECT_TRUE(Parse("1234567890123456789", &u64));
+  EXPECT_EQ(1234567890123456789ULL, u64);
+  EXPECT_TRUE(Parse("18446744073709551615", &u64));
+  EXPECT_EQ(18446744073709551615ULL, u64);
+  EXPECT_FALSE(Parse("18446744073709551616", &u64));
+  EXPECT_FALSE(Parse("99999999999999999999", &u64));
+  EXPECT_FALSE(Parse("100000000000000000000", &u64));
+
+  std::uint8_t u8 = 0;
+  EXPECT_TRUE(Parse("255", &u8));
+  EXPECT_EQ(255, u8);
+  EXPECT_FALSE(Parse("256", &u8));
+}
+
+TEST(BioparserNumericTest, Signed) {
+  std::int32_t i32 = 0;
+  EXPECT_TRUE(Parse("-150", &i32));
+  EXPECT_EQ(-150, i32);
+  EXPECT_TRUE(Parse("+150", &i32));
+  EXPECT_EQ(150, i32);
+  EXPECT_TRUE(Parse("-0", &i32));
+  EXPECT_EQ(0, i32);
+  EXPECT_TRUE(Parse("2147483647", &i32));
+  EXPECT_EQ(2147483647, i32);
+  EXPECT_TRUE(Parse("-2147483648", &i32));
+  EXPECT_EQ(-2147483647 - 1, i32);
+  EXPECT_FALSE(Parse("2147483648", &i32));
+  EXPECT_FALSE(Parse("-2147483649", &i32));
+  EXPECT_FALSE(Parse("-", &i32));
+  EXPECT_FALSE(Parse("--1", &i32));
+
+  std::int64_t i64 = 0;
+  EXPECT_TRUE(Parse("-9223372036854775808", &i64));
+  EXPECT_EQ(INT64_MIN, i64);
+  EXPECT_FALSE(Parse("9223372036854775808", &i64));
+}
+
+TEST(BioparserNumericTest, Double) {
+  double d = 0;
+  EXPECT_TRUE(Parse("0.2339", &d));
+  EXPECT_DOUBLE_EQ(0.2339, d);
+  EXPECT_TRUE(Parse("-1e-3", &d));
+  EXPECT_DOUBLE_EQ(-0.001, d);
+  EXPECT_FALSE(Parse("", &d));
+  EXPECT_FALSE(Parse(" 1", &d));
+  EXPECT_FALSE(Parse("1.5x", &d));
+  EXPECT_FALSE(Parse("nan", &d));
+  EXPECT_FALSE(Parse(std::string(64, '1'), &d));
+}
+
+TEST(BioparserNumericTest, Unterminated) {
+  std::string str = "1234567890123456789";
+  std::uint64_t u64 = 0;
+  for (std::uint32_t i = 1; i <= str.size(); ++i) {
+    EXPECT_TRUE(Numeric::Parse(str.data(), str.data() + i, &u64));
+    EXPECT_EQ(std::stoull(str.substr(0, i)), u64);
+  }
+}
+
+}  // namespace test
+}  // namespace bioparser
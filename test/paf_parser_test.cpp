@@ -2,8 +2,10 @@
 
 #include "bioparser/paf_parser.hpp"
 
+#include <fstream>
 #include <numeric>
 #include <string>
+#include <utility>
 
 #include "biosoup/overlap.hpp"
 #include "gtest/gtest.h"
@@ -48,6 +50,34 @@ struct PafOverlap: public biosoup::Overlap {
   std::uint32_t quality;
 };
 
+struct PafTaggedOverlap: public PafOverlap {
+ public:
+  PafTaggedOverlap(
+      const char* q_name, std::uint32_t q_name_len,
+      std::uint32_t q_len,
+      std::uint32_t q_begin,
+      std::uint32_t q_end,
+      char orientation,
+      const char* t_name, std::uint32_t t_name_len,
+      std::uint32_t t_len,
+      std::uint32_t t_begin,
+      std::uint32_t t_end,
+      std::uint32_t score,
+      std::uint32_t overlap_len,
+      std::uint32_t quality,
+      const char* tags, std::uint32_t tags_len)
+      : PafOverlap(
+          q_name, q_name_len, q_len, q_begin, q_end,
+          orientation,
+          t_name, t_name_len, t_len, t_begin, t_end,
+          score,
+          overlap_len,
+          quality),
+        tags(tags, tags_len) {}
+
+  std::string tags;
+};
+
 class BioparserPafTest: public ::testing::Test {
  public:
   void Setup(const std::string& file) {
@@ -93,6 +123,15 @@ TEST_F(BioparserPafTest, ParseInChunks) {
   Check();
 }
 
+TEST_F(BioparserPafTest, CallbackParseInChunks) {
+  Setup("sample.paf");
+  auto callback = [&] (PafOverlap&& it) {
+    o.emplace_back(new PafOverlap(std::move(it)));
+  };
+  while (p->Parse(1024, callback) > 0) {}
+  Check();
+}
+
 TEST_F(BioparserPafTest, FormatError) {
   Setup("sample.mhap");
   try {
@@ -104,6 +143,33 @@ TEST_F(BioparserPafTest, FormatError) {
   }
 }
 
+TEST_F(BioparserPafTest, ParseTags) {
+  auto tagged = Parser<PafTaggedOverlap>::Create<PafParser>(
+      BIOPARSER_TEST_DATA + std::string("sample.paf"));
+  std::int64_t num_minimizers = 0;
+  auto callback = [&] (PafTaggedOverlap&& it) {
+    Tags::Tag tag;
+    std::int64_t cm = 0;
+    ASSERT_TRUE(Tags(it.tags.data(), it.tags.size()).Find("cm", &tag));
+    ASSERT_TRUE(tag.Parse(&cm));
+    num_minimizers += cm;
+    o.emplace_back(new PafOverlap(std::move(it)));
+  };
+  while (tagged->Parse(1024, callback) > 0) {}
+  Check();
+  EXPECT_EQ(41381, num_minimizers);
+
+  auto path = BIOPARSER_TEST_OUTPUT + std::string("tags.paf");
+  std::ofstream(path) <<
+      "q\t10\t0\t10\t+\tt\t20\t5\t15\t9\t10\t60\ttp:A:P\tcg:Z:10M \n"
+      "q\t10\t0\t10\t+\tt\t20\t5\t15\t9\t10\t60\n";
+  tagged = Parser<PafTaggedOverlap>::Create<PafParser>(path);
+  auto t = tagged->Parse(-1);
+  ASSERT_EQ(2, t.size());
+  EXPECT_EQ("tp:A:P\tcg:Z:10M", t[0]->tags);
+  EXPECT_TRUE(t[1]->tags.empty());
+}
+
 TEST_F(BioparserPafTest, CompressedParseWhole) {
   Setup("sample.paf.gz");
   o = p->Parse(-1);
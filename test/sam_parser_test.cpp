@@ -2,8 +2,10 @@
 
 #include "bioparser/sam_parser.hpp"
 
+#include <fstream>
 #include <numeric>
 #include <string>
+#include <utility>
 
 #include "biosoup/overlap.hpp"
 #include "gtest/gtest.h"
@@ -53,10 +55,42 @@ struct SamOverlap: public biosoup::Overlap {
   std::string quality;
 };
 
+struct SamTaggedOverlap: public SamOverlap {
+ public:
+  SamTaggedOverlap(
+      const char* q_name, std::uint32_t q_name_len,
+      std::uint32_t flag,
+      const char* t_name, std::uint32_t t_name_len,
+      std::uint32_t t_begin,
+      std::uint32_t map_quality,
+      const char* cigar, std::uint32_t cigar_len,
+      const char* t_next_name, std::uint32_t t_next_name_len,
+      std::uint32_t t_next_begin,
+      std::uint32_t template_len,
+      const char* data, std::uint32_t data_len,
+      const char* quality, std::uint32_t quality_len,
+      const char* tags, std::uint32_t tags_len)
+      : SamOverlap(
+          q_name, q_name_len,
+          flag,
+          t_name, t_name_len, t_begin,
+          map_quality,
+          cigar, cigar_len,
+          t_next_name, t_next_name_len, t_next_begin,
+          template_len,
+          data, data_len,
+          quality, quality_len),
+        tags(tags, tags_len) {}
+
+  std::string tags;
+};
+
 class BioparserSamTest: public ::testing::Test {
  public:
-  void Setup(const std::string& file) {
-    p = Parser<SamOverlap>::Create<SamParser>(BIOPARSER_TEST_DATA + file);
+  void Setup(const std::string& file, const Options& options = Options()) {
+    p = Parser<SamOverlap>::Create<SamParser>(
+        BIOPARSER_TEST_DATA + file,
+        options);
   }
 
   void Check() {
@@ -103,6 +137,15 @@ TEST_F(BioparserSamTest, ParseInChunks) {
   Check();
 }
 
+TEST_F(BioparserSamTest, CallbackParseInChunks) {
+  Setup("sample.sam");
+  auto callback = [&] (SamOverlap&& it) {
+    o.emplace_back(new SamOverlap(std::move(it)));
+  };
+  while (p->Parse(1024, callback) > 0) {}
+  Check();
+}
+
 TEST_F(BioparserSamTest, FormatError) {
   Setup("sample.paf");
   try {
@@ -142,5 +185,120 @@ TEST_F(BioparserSamTest, CompressedFormatError) {
   }
 }
 
+TEST_F(BioparserSamTest, BgzfParseWhole) {
+  Options options;
+  options.num_threads = 4;
+  Setup("sample.sam.bgz", options);
+  o = p->Parse(-1);
+  Check();
+}
+
+TEST_F(BioparserSamTest, BgzfParseAndReset) {
+  Options options;
+  options.num_threads = 3;
+  Setup("sample.sam.bgz", options);
+  for (auto t = p->Parse(1024); !t.empty(); t = p->Parse(1024)) {
+  }
+  p->Reset();
+  for (auto t = p->Parse(1024); !t.empty(); t = p->Parse(1024)) {
+    o.insert(
+        o.end(),
+        std::make_move_iterator(t.begin()),
+        std::make_move_iterator(t.end()));
+  }
+  Check();
+}
+
+TEST_F(BioparserSamTest, ParseTags) {
+  auto tagged = Parser<SamTaggedOverlap>::Create<SamParser>(
+      BIOPARSER_TEST_DATA + std::string("sample.sam.gz"));
+  std::uint64_t num_tags = 0;
+  std::uint64_t num_edits = 0;
+  auto callback = [&] (SamTaggedOverlap&& it) {
+    Tags::Tag tag;
+    std::uint64_t nm = 0;
+    if (Tags(it.tags.data(), it.tags.size()).Find("NM", &tag)) {
+      ASSERT_TRUE(tag.Parse(&nm));
+      ++num_tags;
+    }
+    num_edits += nm;
+    o.emplace_back(new SamOverlap(std::move(it)));
+  };
+  while (tagged->Parse(1024, callback) > 0) {}
+  Check();
+  EXPECT_EQ(38, num_tags);
+  EXPECT_EQ(52485, num_edits);
+}
+
+TEST_F(BioparserSamTest, Header) {
+  for (const auto& it : {"sample.sam", "sample.sam.gz"}) {
+    for (bool is_parsed_first : {false, true}) {
+      Setup(it);
+      auto& parser = dynamic_cast<SamParser<SamOverlap>&>(*p);
+      if (is_parsed_first) {
+        for (auto t = p->Parse(1024); !t.empty(); t = p->Parse(1024)) {
+          o.insert(
+              o.end(),
+              std::make_move_iterator(t.begin()),
+              std::make_move_iterator(t.end()));
+        }
+      }
+      const auto& header = parser.header();
+      EXPECT_EQ(0, header.text().find("@SQ\tSN:NC_001416.1\tLN:48502\n@PG\t"));
+      EXPECT_EQ('\n', header.text().back());
+      ASSERT_EQ(1, header.references().size());
+      auto reference = header.Find("NC_001416.1");
+      ASSERT_NE(nullptr, reference);
+      EXPECT_EQ(48502, reference->length);
+      EXPECT_EQ(nullptr, header.Find("NC_001416"));
+      if (!is_parsed_first) {
+        o = p->Parse(-1);
+      }
+      EXPECT_EQ(1, parser.header().references().size());
+      Check();
+      o.clear();
+    }
+  }
+
+  auto path = BIOPARSER_TEST_OUTPUT + std::string("header.sam");
+  std::ofstream(path) << "@HD\tVN:1.6\n@SQ\tSN:chr1\n";
+  p = Parser<SamOverlap>::Create<SamParser>(path);
+  EXPECT_THROW(
+      dynamic_cast<SamParser<SamOverlap>&>(*p).header(),
+      std::invalid_argument);
+}
+
+TEST_F(BioparserSamTest, IndexedParseInRanges) {
+  auto path = BIOPARSER_TEST_DATA + std::string("sample.sam.gz");
+  auto index = GzipIndex::Build(path, 65536);
+  for (std::uint64_t num_ranges : {1, 3, 7}) {
+    auto range_size = index->size() / num_ranges + 1;
+    for (std::uint64_t i = 0; i < num_ranges; ++i) {
+      Options options;
+      options.read_ahead = i % 2 ? 0 : 4;
+      p = Parser<SamOverlap>::Create<SamParser>(
+          path, *index, i * range_size, (i + 1) * range_size, options);
+      for (auto t = p->Parse(1024); !t.empty(); t = p->Parse(1024)) {
+        o.insert(
+            o.end(),
+            std::make_move_iterator(t.begin()),
+            std::make_move_iterator(t.end()));
+      }
+    }
+    Check();
+    o.clear();
+  }
+}
+
+TEST_F(BioparserSamTest, IndexedParseAndReset) {
+  auto path = BIOPARSER_TEST_DATA + std::string("sample.sam.gz");
+  auto index = GzipIndex::Build(path, 65536);
+  p = Parser<SamOverlap>::Create<SamParser>(path, *index, 300000);
+  auto n = p->Parse(-1).size();
+  EXPECT_GT(48, n);
+  p->Reset();
+  EXPECT_EQ(n, p->Parse(-1).size());
+}
+
 }  // namespace test
 }  // namespace bioparser
@@ -0,0 +1,82 @@
+// Copyright (c) 2026 Robert Vaser
+
+#include "bioparser/scanner.hpp"
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace bioparser {
+namespace test {
+
+class BioparserScannerTest: public ::testing::Test {
+ public:
+  void SetUp() override {
+    kernels.emplace_back(&Scanner::Scalar);
+#if defined(BIOPARSER_HAS_SSE2)
+    kernels.emplace_back(&Scanner::Sse2);
+#endif
+#if defined(BIOPARSER_HAS_AVX2)
+    if (__builtin_cpu_supports("avx2")) {
+      kernels.emplace_back(&Scanner::Avx2);
+    }
+#endif
+#if defined(BIOPARSER_HAS_NEON)
+    kernels.emplace_back(&Scanner::Neon);
+#endif
+    kernels.emplace_back(&Scanner::FindFirstOf);
+  }
+
+  std::vector<Scanner::Kernel> kernels;
+};
+
+TEST_F(BioparserScannerTest, Empty) {
+  std::string data = "\n";
+  for (const auto& it : kernels) {
+    EXPECT_EQ(data.data(), it(data.data(), data.data(), '\n', '\n'));
+  }
+}
+
+TEST_F(BioparserScannerTest, FindFirstOf) {
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<int> distribution(0, 255);
+  std::string data(300, 'A');
+  for (std::uint32_t i = 0; i < data.size(); ++i) {
+    data[i] = "ACGT>+\t"[distribution(generator) % 7];
+  }
+  data += '\n';
+
+  // all alignments, lengths and positions of the sought characters
+  for (const auto& it : kernels) {
+    for (std::uint32_t first = 0; first < 70; ++first) {
+      for (std::uint32_t last = first; last < data.size(); ++last) {
+        for (const auto& c : {"\n\n", "\n>", "\n+", "\t\t"}) {
+          auto expected = data.data() + first;
+          while (expected < data.data() + last &&
+                 *expected != c[0] && *expected != c[1]) {
+            ++expected;
+          }
+          EXPECT_EQ(expected, it(
+              data.data() + first, data.data() + last, c[0], c[1]));
+        }
+      }
+    }
+  }
+}
+
+TEST_F(BioparserScannerTest, NonAscii) {
+  std::string data(100, static_cast<char>(0xFF));
+  data[77] = static_cast<char>(0x80);
+  for (const auto& it : kernels) {
+    EXPECT_EQ(data.data() + 77, it(
+        data.data(), data.data() + data.size(), static_cast<char>(0x80), '\n'));
+    EXPECT_EQ(data.data() + data.size(), it(
+        data.data(), data.data() + data.size(), '\n', '\n'));
+  }
+}
+
+}  // namespace test
+}  // namespace bioparser
@@ -0,0 +1,54 @@
+// Copyright (c) 2026 Robert Vaser
+
+#include "bioparser/tags.hpp"
+
+#include <stdexcept>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace bioparser {
+namespace test {
+
+TEST(BioparserTagsTest, Find) {
+  std::string src = "tp:A:P\tcm:i:-39\tde:f:0.0123\tcg:Z:10M2I5M\tZZ:B:c,1,2";
+  Tags tags(src.data(), src.size());
+
+  Tags::Tag tag;
+  ASSERT_TRUE(tags.Find("cg", &tag));
+  EXPECT_EQ('Z', tag.type);
+  EXPECT_EQ("10M2I5M", std::string(tag.value, tag.value_len));
+
+  std::int32_t cm = 0;
+  ASSERT_TRUE(tags.Find("cm", &tag));
+  EXPECT_TRUE(tag.Parse(&cm));
+  EXPECT_EQ(-39, cm);
+
+  double de = 0;
+  ASSERT_TRUE(tags.Find("de", &tag));
+  EXPECT_TRUE(tag.Parse(&de));
+  EXPECT_DOUBLE_EQ(0.0123, de);
+
+  ASSERT_TRUE(tags.Find("ZZ", &tag));
+  EXPECT_EQ("c,1,2", std::string(tag.value, tag.value_len));
+  EXPECT_FALSE(tags.Find("NM", &tag));
+
+  EXPECT_FALSE(Tags().Find("cg", &tag));
+}
+
+TEST(BioparserTagsTest, Decode) {
+  std::string src = "tp:A:P\tcs:Z:";
+  auto tags = Tags(src.data(), src.size()).Decode();
+  ASSERT_EQ(2, tags.size());
+  EXPECT_EQ("tp", std::string(tags[0].name, 2));
+  EXPECT_EQ('A', tags[0].type);
+  EXPECT_EQ(0, tags[1].value_len);
+
+  for (const auto& it : {"tp:A", "tp:X:P", "tp:AP", "tp:A:P\t\tcm:i:1"}) {
+    std::string str(it);
+    EXPECT_THROW(Tags(str.data(), str.size()).Decode(), std::invalid_argument);
+  }
+}
+
+}  // namespace test
+}  // namespace bioparser